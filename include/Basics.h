@@ -30,30 +30,30 @@ class Basics
         Basics();
         virtual ~Basics();
         bool findInString(char c, string s);
-        bool contains(string s, vector<string> v);
+        bool contains(const string &s, const vector<string> &v);
         vector<string> split(string name, char c);
         vector<string> split2(string name, char c1, char c2);
         string head(string name);
         char last(string name);
         int isThat(string s);
-        string join(vector<string> &v, string sep);
+        string join(const vector<string> &v, string sep);
         string joinint(vector<int> &v, string sep);
-        void addToVector(vector<string> &v, vector<string> &w);
+        void addToVector(vector<string> &v, const vector<string> &w);
         void addToVectorP(vector<string>* v, vector<string>* w);
         string format(string text);
-        bool isInt(string text);
-        bool testInt(string text);
-        bool isLong(string text);
-        bool isNumber(string text);
-        bool testNum(string text);
+        bool isInt(const string &text);
+        bool testInt(const string &text);
+        bool isLong(const string &text);
+        bool isNumber(const string &text);
+        bool testNum(const string &text);
         string ctos(char c);
         vector<string> readFile(string name, bool keepEmpty, bool keepEol, bool keepEof);
         vector<string>* readFileP(string name);
-        bool writeFile(string filename, vector<string> &v);
+        bool writeFile(string filename, const vector<string> &v);
         bool isEmpty(string text);
         string getDir(string s);
         bool isPath(string s); // checks if a string is a path (i.e. contains : or / or \)
-        int countOcc(vector<string> &v, string search); // count occurences
+        int countOcc(const vector<string> &v, string search); // count occurences
         string cstos(const char *a);
         vector<string> stov(string s);
         string trimLeft(string text);
@@ -0,0 +1,51 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef CHUNK_H
+#define CHUNK_H
+#include <string>
+#include <vector>
+#include "Enums.h"
+
+using namespace std;
+
+// message of a chunk, logged when the chunks are merged
+struct Event
+{
+    Level level;
+    string text;
+    bool stop; // missing operands: stop the program (stopExecution = 9) instead of logging text
+};
+
+// result of a range of rows of a plist (executed by a thread of the pool)
+// the chunks are merged in row order, so that results and messages are the same as for a serial execution
+struct Chunk
+{
+    vector<string> result;
+    vector<long long int> values; // values of result (plist-int)
+    vector<Event> events;
+    bool kernel = false; // rows executed by the column kernel
+    bool failed = false; // the plist returns nothing
+    bool error = false; // an exception ended the execution, later chunks are ignored
+    string what; // message of the exception
+    int sp = 0; // stack size after the last row
+};
+
+#endif // CHUNK_H
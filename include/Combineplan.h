@@ -0,0 +1,50 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef COMBINEPLAN_H
+#define COMBINEPLAN_H
+#include "List.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// combine pattern like "#w #w #u #f x", every combination takes the next elements of uselist, forlist and withlist
+// for #u, #f and #w (other words with # are ignored). Parsed once by the fourth parse if it consists of plain values,
+// otherwise for every execution
+class Combineplan
+{
+    public:
+        Combineplan(const vector<string> &v);
+        virtual ~Combineplan();
+        long long int combinations(size_t uselen, size_t forlen, size_t withlen) const;
+        void build(long long int c, const List &uselist, const List &forlist, const List &withlist,
+                   vector<string> &row) const;
+        vector<char> slots; // per item: 'p' = plain, 'u' = #u, 'f' = #f, 'w' = #w
+        vector<string> plain; // text of the plain items
+        int uses; // number of #u
+        int fors; // number of #f
+        int withs; // number of #w
+    protected:
+
+    private:
+};
+
+#endif // COMBINEPLAN_H
@@ -30,4 +30,11 @@ enum Codes {ROW, VAL, VAR, IDX, AND, OR, NOT, EQ, NEQ, GE, LE, GT, LT, ELVIS,
 enum Modes {SINGLE, MULTI};
 // note that verbs, refs and vmods are declared in Item
 enum StopTypes {LOOP, PARAGRAPH, PROGRAM};
+// verb ids, set for every verb item and used for dispatching (V_PARAGRAPH = call of a paragraph)
+enum Verbs {V_NONE, V_COND, V_DEL, V_EXPAND, V_FILE, V_FIND, V_FREQ, V_GET, V_ID, V_INCLUDE, V_INPUT, V_INS, V_JOIN, V_MASK, V_MINUS,
+ V_OUTPUT, V_PEXPR, V_PRINT, V_RANGE, V_READLINES, V_REVERSE, V_RETURNVALUE, V_SET, V_SORT, V_SPLIT, V_TIME, V_UNIQUE, V_WRITELINES,
+ V_PLIST, V_BETWEEN, V_NOP, V_STOP, V_PARAGRAPH};
+// list a reference points to (R_SENTENCE = result of a previous sentence) and how it is accessed
+enum RefSlots {R_NONE, R_THIS, R_PARAMS, R_FORPARAMS, R_USEPARAMS, R_WITHPARAMS, R_ARGS, R_SENTENCE};
+enum RefKinds {RK_WHOLE, RK_SIZE, RK_INDEX, RK_RANGE};
 #endif // ENUMS_H
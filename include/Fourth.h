@@ -0,0 +1,68 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef FOURTH_H
+#define FOURTH_H
+#include "Log.h"
+#include "Sentence.h"
+#include "Paragraph.h"
+#include "Basics.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+// links the paragraphs after the third parse, i.e. resolves all verbs to ids and paragraph indexes
+class Fourth  : public Basics
+{
+    public:
+        Fourth();
+        virtual ~Fourth();
+        int fourthParse(vector<Paragraph> v);
+        string getContentString();
+        vector<Paragraph> getParagraphs();
+        int linkVerbs(Paragraph &p);
+        void linkRefs(Paragraph &p);
+        void linkRefs(vector<Item> &items, int sc, vector<int> &lastUse);
+        void markTailCalls(Paragraph &p, int index);
+        bool isReturnOfThis(Sentence &sentence);
+        bool isEmptyNop(Sentence &sentence);
+        void checkMemo();
+        void checkParallel(vector<string> &impure);
+        string getImpureVerb(Paragraph &p);
+        bool readsCallerThis(Paragraph &p);
+        bool readsThis(vector<Item> &items);
+        void compilePrograms(Paragraph &p);
+        void compileProgram(Sentence &sentence);
+        void compileRowplan(Sentence &sentence);
+        void compileCombineplan(Sentence &sentence);
+        void fuse(Sentence &sentence);
+        void dispatch(Paragraph &p);
+        bool isCase(Sentence &sentence);
+        bool isSameRef(Item &a, Item &b);
+    protected:
+
+    private:
+        // list of linked paragraphs, par. 0 is the start paragraph
+        vector<Paragraph> paragraphs;
+        unordered_map<string, int> names;
+        Log log;
+};
+
+#endif // FOURTH_H
@@ -0,0 +1,65 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FRAME_H
+#define FRAME_H
+#include <string>
+#include <vector>
+#include <utility>
+#include "List.h"
+#include "Slist.h"
+#include "Enums.h"
+
+using namespace std;
+
+// call of a pure paragraph by a later sentence, executed by a worker while the current sentence is executed.
+// Its result is taken if the sentence is reached and its parameters are the same.
+struct Ahead
+{
+    int sc = -1; // sentence of the call, -1 = none
+    List dolist;
+    List forlist;
+    List uselist;
+    List withlist;
+    List result;
+    int stop = 0; // stopExecution after the call
+    vector<pair<Level, string>> messages;
+};
+
+// activation of a paragraph on the interpreter's own call stack
+struct Frame
+{
+    int index; // paragraph
+    int sc; // current sentence
+    int stackLevel;
+    bool waiting = false; // true while the current sentence waits for a called paragraph
+    List thislist; // result of the previous sentence
+    List dolist; // parameters of the call
+    List forlist;
+    List uselist;
+    List withlist;
+    vector<Slist> slists; // saved sentence results
+    vector<string> totalrv; // collected return values
+    int tailMark = -1; // size of totalrv at the last tail call which reused this frame
+    bool memo = false; // the result is cached under memoKey when the paragraph returns
+    string memoKey;
+    Ahead ahead;
+};
+
+#endif // FRAME_H
@@ -24,14 +24,27 @@ This file is part of the SOPL Interpreter.
 #include "Paragraph.h"
 #include "Item.h"
 #include "Rowdefs.h"
+#include "Slist.h"
+#include "List.h"
+#include "Frame.h"
 #include "Opcode.h"
+#include "Program.h"
+#include "Chunk.h"
+#include "Pool.h"
 #include "Rowitem.h"
+#include "Rowplan.h"
+#include "Combineplan.h"
 #include "Datetime.h"
 #include "Basics.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <stack>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <atomic>
 
 using namespace std;
 
@@ -43,52 +56,100 @@ class Interpreter : public Basics
         void setNames();
         void setParagraphs(vector<Paragraph> v);
         string getNameList();
-        vector<string> getTheParam(vector<Item> &items, int sc, vector<string> &thislist, vector<string> &dolist, vector<string> &forlist, vector<string> &uselist, vector<string> &withlist,
-                                        int stackLevel,  unordered_map<int, vector<string>> &slists);
-        vector<string> getTheReference(Item item, int sc, vector<string> &thislist, vector<string> &dolist, vector<string> &forlist, vector<string> &uselist, vector<string> &withlist,
-                             unordered_map<int, vector<string>> &slists);
-        vector<string> getSlist(unordered_map<int, vector<string>> &slists, int key);
+        List getTheParam(vector<Item> &items, int sc, List &thislist, List &dolist, List &forlist, List &uselist, List &withlist,
+                                        int stackLevel,  vector<Slist> &slists);
+        List getTheReference(Item &item, List &thislist, List &dolist, List &forlist, List &uselist, List &withlist,
+                             vector<Slist> &slists);
+        List& getRefList(Item &item, List &thislist, List &dolist, List &forlist, List &uselist, List &withlist,
+                             vector<Slist> &slists);
+        List& getSlist(vector<Slist> &slists, int key);
+        void releaseSlists(vector<Slist> &slists);
+        void releaseSlists(vector<Slist> &slists, vector<int> &indexes);
         // exec section
         int execute(vector<string> &pargs);
-        vector<string> execParagraph(int index, vector<string> &pthislist, vector<string> &pdolist, vector<string> &pforlist, vector<string> &puselist, vector<string> &pwithlist,
+        List execParagraph(int index, List &pthislist, List &pdolist, List &pforlist, List &puselist, List &pwithlist,
+                               int stackLevel, bool memo);
+        bool pushFrame(int index, List &pthislist, List &pdolist, List &pforlist, List &puselist, List &pwithlist,
                                int stackLevel);
-        tuple<int, vector<string>> executeVerb(Item verb, int jump,
-                    vector<string> &thislist, vector<string> &dolist, vector<string> &forlist, vector<string> &uselist, vector<string> &withlist, int stackLevel);
-        tuple<int, vector<string>> executePlainVerb(string name, bool isStandardVerb, int jump, string stype,
-                    vector<string> &thislist, vector<string> &dolist, vector<string> &forlist, vector<string> &uselist, vector<string> &withlist, int stackLevel);
-        tuple<int, vector<string>> executePerRowSentence3(string name, bool isStandardVerb, int jump, string stype,
-                    vector<string> &thislist, vector<string> &dolist, vector<string> &forlist, vector<string> &uselist, vector<string> &withlist, int stackLevel);
-        tuple<int, vector<string>> executeCombineSentence(string name, bool isStandardVerb, int jump, string stype,
-                    vector<string> &thislist, vector<string> &dolist, vector<string> &forlist, vector<string> &uselist, vector<string> &withlist, int stackLevel);
-        tuple<int, vector<string>> executeStandardVerb(string name, string stype,
-                    vector<string> &dolist, vector<string> &forlist, int offset);
-        vector<string> vminus(vector<string> v, vector<string> w);
-        void doPrint(vector<string> v, bool withCrlf);
-        void doOut(vector<string> v, bool withCrlf);
+        void popFrame();
+        void reuseFrame(Frame &f, List &pdolist, List &pforlist, List &puselist, List &pwithlist);
+        List run(size_t base);
+        void execSentence(Frame &f);
+        bool execFused(Frame &f, Sentence &sentence, Program &prog, List &p, int &offset);
+        bool execRowplan(const Rowplan &plan, Program &prog, bool isLong, int i, const List &uselist, const List &withlist,
+                         vector<string> &result, Chunk &ch);
+        bool dispatchTo(Program &prog, int found, List &p, int &offset);
+        bool getFusedOperand(Frame &f, Item &item, const List *&list, int &index);
+        void returnToCaller(Frame &f, List &result);
+        void nextSentence(Frame &f, int offset);
+        int findAhead(Frame &f);
+        bool isForkable(Sentence &sentence);
+        bool dependsOn(Sentence &sentence, int from, int to);
+        bool executeAhead(Frame &f, List &dolist, List &forlist, List &uselist, List &withlist);
+        bool takeAhead(Frame &f, List &dolist, List &forlist, List &uselist, List &withlist);
+        bool isCancelled();
+        unique_ptr<Interpreter> takeSpare();
+        void releaseSpare(unique_ptr<Interpreter> helper);
+        void sentenceError(Frame &f, exception &e, string hint);
+        void setMaxDepth(int depth);
+        void setMaxMemo(int size);
+        void setThreads(int n);
+        void setExactMath(bool exact);
+        string getMemoKey(int index, List &pthislist, List &pdolist, List &pforlist, List &puselist, List &pwithlist);
+        void addMemoKey(string &key, List &list);
+        void storeMemo(int index, string &key, List &result);
+        void beginVerb(Item &verb, List &dolist);
+        void endVerb(Item &verb, List &p);
+        tuple<int, List> executeVerb(Item &verb, int jump,
+                    List &thislist, List &dolist, List &forlist, List &uselist, List &withlist, int stackLevel);
+        tuple<int, List> executePlainVerb(Item &verb, int jump, string stype,
+                    List &thislist, List &dolist, List &forlist, List &uselist, List &withlist, int stackLevel);
+        tuple<int, List> executePerRowSentence3(Item &verb, int jump, string stype,
+                    List &thislist, List &dolist, List &forlist, List &uselist, List &withlist, int stackLevel);
+        bool isParallel(Item &verb, long long int rows);
+        void executeRowsParallel(int rows, List &thislist, List &forlist, List &uselist, List &withlist,
+                                 bool warnEmpty, const string &name, vector<string> &result,
+                                 const function<bool(Interpreter &, int, List *, List &)> &execRow);
+        bool buildRow(const Rowplan &plan, int i, const string &name, const List &uselist, const List &withlist,
+                      const vector<string> &result, vector<string> &row);
+        tuple<int, List> executeCombineSentence(Item &verb, int jump, string stype,
+                    List &thislist, List &dolist, List &forlist, List &uselist, List &withlist, int stackLevel);
+        tuple<int, List> executeParallelSentence(Item &verb, int jump,
+                    List &thislist, List &dolist, List &forlist, List &uselist, List &withlist, int stackLevel);
+        tuple<int, List> executeStandardVerb(Verbs verb, string stype,
+                    List &dolist, List &forlist, int offset, Program *program);
+        vector<string> vminus(const vector<string> &v, const vector<string> &w);
+        void doPrint(const vector<string> &v, bool withCrlf);
+        void doOut(const vector<string> &v, bool withCrlf);
 
-        vector<string> bulkExecInt(Modes mode, vector<string> &ops, vector<string> &liste, vector<string> &uselist, vector<string> &withlist);
-        vector<string> bulkExecLong(Modes mode, vector<string> &ops, vector<string> &liste, vector<string> &uselist, vector<string> &withlist);
-        vector<string> bulkExecString(Modes mode, vector<string> &ops, vector<string> &liste, vector<string> &uselist, vector<string> &withlist);
-        vector<string> bulkExecFloat(Modes mode, vector<string> &ops, vector<string> &liste, vector<string> &uselist, vector<string> &withlist);
-
-        int getRight(string op, int pre);
-        vector<Opcode> toOpcode(vector<string> v);
+        vector<string> bulkExecInt(Modes mode, const vector<string> &ops, const vector<string> &liste, const vector<string> &uselist, const vector<string> &withlist);
+        List bulkExecLong(Modes mode, const List &ops, const List &liste, const List &uselist, const List &withlist,
+                          Program *program);
+        vector<string> bulkExecString(Modes mode, const List &ops, const List &liste, const List &uselist, const List &withlist,
+                                      Program *program);
+        vector<string> bulkExecFloat(Modes mode, const List &ops, const List &liste, const List &uselist, const List &withlist,
+                                     Program *program);
+        Program& getProgram(Program *program, const List &ops, Program &local);
+        int countChunks(Modes mode, int rows, int incr);
+        void execRowsLong(Modes mode, Program &prog, const List &ops, const List &liste, const List &uselist, const List &withlist,
+                          const long long int *lv, int first, int last, bool cache, Chunk &ch);
+        void execRowsFloat(Modes mode, Program &prog, const List &ops, const List &liste, const List &uselist, const List &withlist,
+                           int first, int last, bool cache, Chunk &ch);
+        bool mergeChunks(Modes mode, const List &ops, string stype, vector<Chunk> &chunks,
+                         vector<string> &result, vector<long long int> &values);
         int ipower(int b, int e);
         long long int lpower(long long int b, long long int e);
         int getDefLength(string text);
-        int getRowLength(vector<string> v);
         int newStopExecution(int old, StopTypes stype);
-        Rowdefs getPerRowDefs(vector<string>& v);
-        vector<Rowitem> getPerRowItems(int start, vector<string>& v);
         //string times(string s, int t);
-        vector<bool> getUp(vector<string> therange);
+        vector<bool> getUp(const vector<string> &therange);
         int getRangeIndex(string r, string prev);
-        vector<string> getRange(string sfrom, string sto, string sprev, bool up);
+        vector<int> getRange(string sfrom, string sto, string sprev, bool up);
         vector<string> fileop(string op, string filename);
-        vector<string> timeverb(vector<string> &tv);
-        vector<string> freq(vector<string> &dolist,vector<string> &forlist);
-        void sortRowsLong(int index, int rows, bool isDesc, vector<string> &v, vector<string> &p);
-        void sortRowsString(int index, int rows, bool isDesc, vector<string> &v, vector<string> &p);
+        vector<string> timeverb(const vector<string> &tv);
+        vector<string> freq(const List &dolist, const vector<string> &forlist);
+        void sortRowsLong(int index, int rows, bool isDesc, const List &v, vector<string> &p);
+        void sortRowsString(int index, int rows, bool isDesc, const vector<string> &v, vector<string> &p);
         template <class string> struct gtstoi {
             bool operator() (const string& x, const string& y) const {return stoi(x)>stoi(y);}
             typedef string first_argument_type;
@@ -101,26 +162,33 @@ class Interpreter : public Basics
             typedef string second_argument_type;
             typedef bool result_type;
         };
-        template <class string> struct gtstoll {
-            bool operator() (const string& x, const string& y) const {return stoll(x)>stoll(y);}
-            typedef string first_argument_type;
-            typedef string second_argument_type;
-            typedef bool result_type;
-        };
-        template <class string> struct ltstoll {
-            bool operator() (const string& x, const string& y) const {return stoll(x)<stoll(y);}
-            typedef string first_argument_type;
-            typedef string second_argument_type;
-            typedef bool result_type;
-        };
 
         int vmemsize(vector<string> v);
-        int mmemsize(unordered_map<int, vector<string>> slists);
+        int mmemsize(vector<Slist> &slists);
     int ms = 0;
     protected:
 
     private:
+        Interpreter(Interpreter *parent);
         vector<Paragraph> paragraphs;
+        deque<Frame> frames; // call stack of paragraphs, a deque keeps references to frames valid when pushing
+        size_t depth; // number of active frames, the frames above are kept for reuse
+        static const size_t FRAME_POOL = 256; // maximum number of unused frames
+        int maxDepth; // 0 = no limit
+        vector<unordered_map<string, List>> memos; // cached results per paragraph (modifier memo)
+        int maxMemo; // maximum number of cached results per paragraph, 0 = no limit
+        shared_ptr<Pool> pool; // threads executing the rows of plist and perRow (option -threads=N), shared with the helpers
+        vector<unique_ptr<Interpreter>> helpers; // interpreters of the workers of a parallel perRow, created when first needed
+        Interpreter *root; // interpreter of the program, it keeps the spare helpers of calls executed ahead
+        vector<unique_ptr<Interpreter>> spares;
+        mutex spareLock;
+        Interpreter *outer; // interpreter which started this helper (nullptr for the root)
+        atomic<bool> cancelled; // set if the result of the call executed ahead is not needed
+        size_t forkDepth; // calls are only executed ahead below this depth of the frame stack (0 = never)
+        size_t baseDepth; // depth of the frame stack of the interpreter which started this helper
+        static const int FORK_LEVELS = 4; // levels of calls executed ahead in addition to 2 * log2(threads)
+        static const int MIN_ROWS = 4096; // minimum number of rows per chunk of a plist
+        bool exactMath; // libm for every value of sin, exp ... in plist-float (option -exactmath)
         unordered_map<string, int> names;
         Log logg;
         Level current;
@@ -128,9 +196,10 @@ class Interpreter : public Basics
         int stopExecution; //0= dont stop, 1 = jump to paragraph end, 2 = intermediate, 3= stop paragraph and surrounding loop, 9 = stopProgram
         string workDir;
         string currDir;
-        vector<string> progargs;
+        List progargs;
         bool logOutput;
         vector<string> vempty;
+        List lempty;
         Datetime datetime;
 };
 
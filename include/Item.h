@@ -21,11 +21,16 @@ This file is part of the SOPL Interpreter.
 #define ITEM_H
 #include <string>
 #include <vector>
+#include <memory>
 #include "Basics.h"
 #include "Log.h"
 
 using namespace std;
 
+class Program;
+class Rowplan;
+class Combineplan;
+
 class Item: public Basics
 {
     public:
@@ -44,9 +49,37 @@ class Item: public Basics
         bool isStandardVerb();
         bool hasGetSize();
         bool hasForget();
+        bool hasMemo();
+        void clearMemo();
+        int getChunk();
+        string getReduce();
+        int getReduceIndex();
+        void setReduceIndex(int index);
+        void clearParallel();
         int getRefFrom();
         int getRefTo();
         int getVerbType();
+        Verbs getVerbId();
+        Verbs toVerbId(string vname);
+        int getParaIndex();
+        void setParaIndex(int index);
+        string getStype();
+        int getVerbMode();
+        bool hasEchoIn();
+        bool hasEchoOut();
+        bool hasModInt();
+        bool hasModFloat();
+        void setRefSlot();
+        RefSlots getRefSlot();
+        RefKinds getRefKind();
+        int getRefSentence();
+        void setRefSentence(int sc);
+        Program* getProgram();
+        void setProgram(shared_ptr<Program> p);
+        Rowplan* getRowplan();
+        void setRowplan(shared_ptr<Rowplan> p);
+        Combineplan* getCombineplan();
+        void setCombineplan(shared_ptr<Combineplan> p);
 
         vector<string> getSentenceRefnames();
         vector<string> getTrueParts();
@@ -57,8 +90,20 @@ class Item: public Basics
     private:
         bool isError;
         int verbType; // 0=no verb,1 =standard, 2 = other, 3 = Paragraph
+        Verbs verbId;
+        int paraIndex; // index of the called paragraph, set by the fourth parse
+        string stype; // set by modifiers int (=long) and float
+        int verbMode; // 0 = plain, 1 = perRow, 2 = combine, 3 = parallel
+        bool echoIn;
+        bool echoOut;
+        bool modInt;
+        bool modFloat;
         bool getSize;
         bool forget;
+        bool memo; // cache the results of a paragraph call
+        int chunk; // elements per chunk of modifier parallel, 0 = one chunk per thread
+        string reduce; // paragraph combining the results of the chunks of modifier parallel
+        int reduceIndex; // index of the paragraph reduce, set by the fourth parse
         char typ; // p=plain, r=ref, v=verb, l=Label, c = condition label, n = newline
         string entry; // full name
         string name; // true name without modifiers
@@ -68,6 +113,12 @@ class Item: public Basics
         vector<string> parts; //modifiers incl. true name
         int refFrom;
         int refTo;
+        RefSlots refSlot;
+        RefKinds refKind;
+        int refSentence; // index of the referenced sentence, set by the fourth parse
+        shared_ptr<Program> program; // compiled ops of plist/pexpr/cond, set by the fourth parse
+        shared_ptr<Rowplan> rowplan; // parsed pattern of perRow, set by the fourth parse
+        shared_ptr<Combineplan> combineplan; // parsed pattern of combine, set by the fourth parse
         Log log;
 //        static vector<string> refs;
 //        static vector<string>  gwords;
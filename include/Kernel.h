@@ -0,0 +1,55 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef KERNEL_H
+#define KERNEL_H
+#include "Basics.h"
+#include "Program.h"
+#include "List.h"
+#include "Vmath.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// executes a straight-line plist program column by column, i.e. every opcode for a block of rows at once,
+// so that the loops over the rows can be vectorized by the compiler.
+// The results are the same as the ones of the row by row execution in bulkExecLong/bulkExecFloat.
+// run returns false if the rows cannot be processed (e.g. a value is not numeric),
+// the caller executes the program row by row then.
+class Kernel : public Basics
+{
+    public:
+        Kernel(const Program &p, bool exact);
+        virtual ~Kernel();
+        bool runLong(const List &liste, const long long int *lv, int len, int incr, int from, int to, bool cache,
+                     bool hasdefault, long long int def, vector<string> &result, vector<long long int> &values);
+        bool runFloat(const List &liste, int len, int incr, int from, int to, bool cache, bool hasdefault, double def,
+                      vector<string> &result);
+        static const int BLOCK = Vmath::COLUMN; // rows per block, the columns of a block stay in the cache
+    protected:
+
+    private:
+        const Program &prog;
+        bool exactMath; // libm for all values of sin, exp ... (option -exactmath)
+        Vmath vm;
+};
+
+#endif // KERNEL_H
@@ -0,0 +1,107 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LIST_H
+#define LIST_H
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+using namespace std;
+
+// content shared by the copies of a list
+// the numeric values of the elements are parsed when first needed (or set by the verb which computed them)
+struct ListContent
+{
+    vector<string> v;
+    vector<long long int> longs;
+    vector<double> doubles;
+    vector<unsigned char> known; // per element: bit 1 = longs valid, bit 2 = doubles valid, empty = nothing known
+};
+
+// list value of the interpreter (this, params, sentence results ...)
+// all copies of a list share the same content, which is only copied when one of them is changed (copy on write)
+// a slice (e.g. params~tail) is a view on a part of the shared content, it is copied only if a verb needs a vector
+class List
+{
+    public:
+        List();
+        List(const vector<string> &v);
+        List(vector<string> &&v);
+        List(vector<string> &&v, vector<long long int> &&longs);
+        ~List();
+        // read access, kept in the header so it can be inlined
+        size_t size() const {return data ? (sliced ? length : data->v.size()) : 0;}
+        bool empty() const {return size() == 0;}
+        const string& operator[](size_t index) const {return data->v[offset + index];}
+        const vector<string>& vec() const {if (sliced) {materialize();} return data ? data->v : none;}
+        const string& at(size_t index) const;
+        const string& back() const;
+        vector<string>::const_iterator begin() const;
+        vector<string>::const_iterator end() const;
+        List slice(size_t from, size_t to) const;
+        bool isSlice() const;
+        // numeric value of an element, parsed like stoll/stod but only once
+        long long int getLong(size_t index) const {
+            size_t k = offset + index;
+            if ((index < size()) && (k < data->known.size()) && (data->known[k] & 1)) {return data->longs[k];}
+            return parseLong(index);
+        }
+        double getDouble(size_t index) const {
+            size_t k = offset + index;
+            if ((index < size()) && (k < data->known.size()) && (data->known[k] & 2)) {return data->doubles[k];}
+            return parseDouble(index);
+        }
+        // the same without storing the parsed value, can be called by several threads at once
+        long long int peekLong(size_t index) const {
+            size_t k = offset + index;
+            if (index >= size()) {throw out_of_range("List::peekLong");}
+            return ((k < data->known.size()) && (data->known[k] & 1)) ? data->longs[k] : stoll(data->v[k]);
+        }
+        double peekDouble(size_t index) const {
+            size_t k = offset + index;
+            if (index >= size()) {throw out_of_range("List::peekDouble");}
+            return ((k < data->known.size()) && (data->known[k] & 2)) ? data->doubles[k] : stod(data->v[k]);
+        }
+        const long long int* longValues() const;
+        // write access, copies the content if it is shared or a slice
+        vector<string>& edit();
+        void push(const string &s);
+        void append(const List &other);
+        void clear();
+        bool isShared() const;
+        // set by the threads of a parallel perRow, getLong/getDouble then parse without storing the value
+        static thread_local bool concurrent;
+
+    protected:
+
+    private:
+        mutable shared_ptr<ListContent> data;
+        mutable size_t offset;
+        mutable size_t length;
+        mutable bool sliced;
+        static const vector<string> none;
+        void materialize() const;
+        long long int parseLong(size_t index) const;
+        double parseDouble(size_t index) const;
+        void own();
+};
+
+#endif // LIST_H
@@ -22,6 +22,8 @@ This file is part of the SOPL Interpreter.
 #include <string>
 #include "Enums.h"
 #include <chrono>
+#include <vector>
+#include <utility>
 
 using namespace std;
 
@@ -31,6 +33,8 @@ class Log
         static bool useconsole;
         static string filename;
         static Level level;
+        // if set, the messages of the thread are kept here instead of being written (by the workers of a parallel perRow)
+        static thread_local vector<pair<Level, string>> *capture;
         Log();
         virtual ~Log();
         void msg(Level lv, string text);
@@ -30,7 +30,12 @@ class Opcode
         Codes op;
         int left;
         string sleft;
+        int pos; // position of a plain value in the list of ops, -1 = other
         unsigned int operands;
+        long long int lvalue; // pre-parsed plain value, if hasLong
+        double dvalue; // pre-parsed plain value, if hasDouble
+        bool hasLong;
+        bool hasDouble;
         Opcode();
         virtual ~Opcode();
 
@@ -32,19 +32,26 @@ class Paragraph
         Paragraph();
         virtual ~Paragraph();
         void addSentence(Sentence sentence);
-        Sentence getSentence(int index);
+        Sentence& getSentence(int index);
+        void setSentence(int index, Sentence sentence);
         void setName(string s);
         string getName();
         string getContentString();
         void setSaved(int index);
         int getLength();
         bool isHeader();
+        void setReadsThis(bool b);
+        bool readsThis();
+        void setPure(bool b);
+        bool isPure();
     protected:
 
     private:
         string name;
         vector<Sentence> sentences;
         bool header;
+        bool callerThis; // this of the caller is read, set by the fourth parse
+        bool pure; // no in- or output, also not by called paragraphs, set by the fourth parse
         Log log;
 };
 
@@ -0,0 +1,67 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef POOL_H
+#define POOL_H
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+using namespace std;
+
+// threads executing the tasks 0..n-1 of a job, the calling thread takes part in the job.
+// A task may start a job of its own: the idle threads take the tasks of the oldest job first,
+// a thread waiting for the end of its job meanwhile executes tasks of other jobs.
+// A job of one task is executed by the calling thread alone.
+class Pool
+{
+    public:
+        Pool();
+        virtual ~Pool();
+        void setThreads(int n);
+        int getThreads();
+        bool hasIdle();
+        void run(int tasks, const function<void(int)> &task);
+
+    protected:
+
+    private:
+        struct Job
+        {
+            const function<void(int)> *task;
+            int total; // number of tasks of the job
+            int next; // next task to take
+            int open; // tasks not yet finished
+        };
+        void work();
+        int take(Job &job);
+        vector<thread> workers;
+        mutex m;
+        condition_variable changed; // a job was started or finished
+        deque<Job *> jobs; // jobs with tasks not yet taken, the oldest first
+        int queued; // tasks not yet taken
+        int idle; // threads waiting for a task
+        bool quit;
+};
+
+#endif // POOL_H
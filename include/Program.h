@@ -0,0 +1,121 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef PROGRAM_H
+#define PROGRAM_H
+#include "Basics.h"
+#include "Opcode.h"
+#include "List.h"
+#include "Log.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+// compact form of an opcode, executed by the row loops of plist/pexpr
+struct Instr {
+    Codes op;
+    unsigned int operands;
+    int left; // var index, skip distance
+    bool hasLong;
+    bool hasDouble;
+    long long int lvalue;
+    double dvalue;
+    int code; // index in codes, for plain values which are not pre-parsed
+};
+
+// pexpr-int like "params 1 -" or cond like "params 0 ==" (two operands and an operator), see Fourth::fuse
+struct Fused {
+    char type; // l = int, d = float, s = string
+    Codes op;
+    int ref[2]; // position of the operand's reference in the params, -1 for a plain value
+    long long int lvalue[2];
+    double dvalue[2];
+    string svalue[2];
+    List yes; // results of a cond
+    List no;
+};
+
+// chain of fused conds "x 1 ==", "x 2 ==", ... whose false jumps lead from one to the next and which test the same
+// reference, the offset of the sentence after the fulfilled cond is found by its constant, see Fourth::dispatch
+struct Dispatch {
+    unordered_map<long long int, int> longs;
+    unordered_map<double, int> doubles;
+    unordered_map<string, int> strings;
+    int other; // offset if no cond is fulfilled
+    int length; // number of conds
+};
+
+// opcodes of plist, pexpr and cond
+// a sentence whose ops are known when parsing is compiled once by the fourth parse, otherwise the ops are compiled
+// for every execution. The leading row/def opcodes are evaluated when compiling and are not part of codes.
+class Program : public Basics
+{
+    public:
+        Program();
+        virtual ~Program();
+        void compile(const vector<string> &ops, const vector<int> &pholes);
+        bool bind(const List &ops);
+        Opcode toOpcode(const string &code, int pos);
+        bool isCompiled();
+        bool hasHoles();
+        vector<Opcode> codes;
+        vector<int> holes; // positions of ops given by references with a single value, set by bind
+        int prefixLength; // number of leading row/def opcodes
+        bool hasPrefix; // row/def found, not allowed for pexpr
+        int incr; // row length
+        bool hasdefault;
+        int def; // default for int/float
+        string sdef; // default for string
+        int maxvar; // largest var index, 1 if a default is set
+        vector<Instr> instrs; // codes as compact instructions
+        int stackSize; // operands pushed by one pass through the instructions
+        bool backJump; // skpz with negative distance, the stack size is not bounded then
+        int outs; // outputs of one pass through the instructions, -1 if skpz/end may skip some
+        bool longKernel; // straight-line program for the column kernels of int/float, see Kernel
+        bool floatKernel;
+        int depth; // stack size after a pass of a straight-line program
+        int maxDepth;
+        bool foldLong();
+        bool foldValue();
+        static bool applyLong(Codes op, long long int il, long long int ir, long long int &result);
+        static bool testDouble(Codes op, double dl, double dr, bool &result);
+        bool testString(Codes op, const string &sl, const string &sr, bool &result);
+        bool isPlainValue(const string &code);
+        static bool startsNumber(const string &code, bool isLong);
+        bool folded; // pexpr-int or cond of plain values, computed by the fourth parse
+        List constant; // its result
+        bool fulfilled; // folded cond
+        bool fused; // pexpr-int or cond of two operands and an operator, evaluated without building the ops
+        Fused fusion;
+        bool dispatched; // first cond of a chain, see Dispatch
+        Dispatch dispatch;
+    protected:
+
+    private:
+        void parseValue(Opcode &op);
+        void link();
+        void checkKernel();
+        bool compiled;
+        Log log;
+};
+
+#endif // PROGRAM_H
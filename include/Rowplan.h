@@ -0,0 +1,53 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ROWPLAN_H
+#define ROWPLAN_H
+#include "Basics.h"
+#include "Rowdefs.h"
+#include "Rowitem.h"
+#include "Program.h"
+#include <string>
+#include <vector>
+#include <memory>
+
+using namespace std;
+
+// perRow pattern like "row2 def0 | # #2 #w1", parsed once by the fourth parse if it consists of plain values,
+// otherwise for every execution
+class Rowplan : public Basics
+{
+    public:
+        Rowplan(const vector<string> &v);
+        virtual ~Rowplan();
+        void compile();
+        Rowdefs rowdefs;
+        vector<Rowitem> rowitems;
+        vector<string> errors; // row lengths which are no integers, reported when executing
+        bool foundBar;
+        bool readsResult; // #rN or #rend, every row depends on the results of the rows before
+        shared_ptr<Program> program; // the items as ops of pexpr-int/float, nullptr if they are no program
+        vector<int> slots; // instruction of every item which is not plain, -1 for the plain items
+    protected:
+
+    private:
+};
+
+#endif // ROWPLAN_H
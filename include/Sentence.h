@@ -47,12 +47,17 @@ class Sentence : public Basics
         void setSaved();
         bool isSaved();
         vector<int> getThatRefs();
+        void addRelease(int index);
+        vector<int>& getReleases();
+        void setTailCall();
+        bool isTailCall();
         void setSeq(int s);
         int getSeq();
         string getContentString(bool withType, bool withDiff);
         int getLength();
         Item getItem(int index);
         Item getLastItem();
+        Item& getVerb();
         void setCondLevel(int s);
         int getCondLevel();
         void setJump(int s);
@@ -74,6 +79,8 @@ class Sentence : public Basics
         int condLevel;
         int jump;
         int labelType;
+        vector<int> releases; // saved results which are not read after this sentence, set by the fourth parse
+        bool tailCall; // call of the own paragraph whose result is only returned, set by the fourth parse
         Log log;
 };
 
@@ -0,0 +1,36 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SLIST_H
+#define SLIST_H
+#include <string>
+#include <vector>
+#include "List.h"
+
+using namespace std;
+
+// saved result of a sentence within one paragraph call
+// valid is false as long as the sentence was not executed or after the result was released
+struct Slist
+{
+    bool valid = false;
+    List list;
+};
+
+#endif // SLIST_H
@@ -0,0 +1,56 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef VMATH_H
+#define VMATH_H
+#include <vector>
+
+using namespace std;
+
+// math functions for a column of values (used by the column kernel of plist-float).
+// The approximations are computed by loops without branches, which the compiler can vectorize,
+// arguments outside their range are computed by libm in a second loop.
+// Results differ from libm by at most 1 ulp for exp and log, 2 ulp for log10, sin, cos, sinh, cosh and tanh
+// and 4 ulp for tan (measured for random arguments), i.e. the relative error is below 1e-15.
+// NaN, infinities, zeros and subnormal numbers give the same results as with libm.
+// The option -exactmath uses libm for all values.
+class Vmath
+{
+    public:
+        Vmath();
+        virtual ~Vmath();
+        void vexp(double *x);
+        void vlog(double *x);
+        void vlog10(double *x);
+        void vsin(double *x);
+        void vcos(double *x);
+        void vtan(double *x);
+        void vsinh(double *x);
+        void vcosh(double *x);
+        void vtanh(double *x);
+        static const int COLUMN = 256; // number of values of a column
+
+    protected:
+
+    private:
+        vector<double> help; // column for intermediate values
+};
+
+#endif // VMATH_H
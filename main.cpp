@@ -29,6 +29,7 @@ This file is part of the SOPL Interpreter.
 #include "Log.h"
 #include "Second.h"
 #include "Third.h"
+#include "Fourth.h"
 #include "Interpreter.h"
 #include "Basics.h"
 #include "Preprocess.h"
@@ -46,6 +47,7 @@ using namespace std;
 
 string Log::filename = "";
 Level Log::level = DEBUG;
+thread_local vector<pair<Level, string>> *Log::capture = nullptr;
 // L = debug output for lexer
 // P = debug output for parser
 // I = debug output for interpreter
@@ -81,6 +83,7 @@ int main(int argc, char *argv[])
     Parser ps;
     Second p2;
     Third p3;
+    Fourth p4;
     Log log;
 
     log.setFile("Logfile.log");
@@ -89,6 +92,10 @@ int main(int argc, char *argv[])
     vector<string> v;
     vector<string> pargs;
     bool logOutput = false;
+    int maxDepth = 0;
+    int maxMemo = 0;
+    int threads = 1;
+    bool exactMath = false;
     bool foundFile = false;
     int retcode = 0;
 
@@ -110,6 +117,30 @@ int main(int argc, char *argv[])
             ix = 3;
         } else if (sargv == "-L") {
             logOutput = true;
+        } else if  (sargv.substr(0,7) == "-depth=") {
+            // limit for the depth of paragraph calls
+            if (b.isInt(sargv.substr(7))) {
+                maxDepth = stoi(sargv.substr(7));
+            } else {
+                log.msg(WARN, "Invalid depth in option " + sargv);
+            }
+        } else if  (sargv.substr(0,6) == "-memo=") {
+            // limit for the number of cached results per paragraph (modifier memo)
+            if (b.isInt(sargv.substr(6))) {
+                maxMemo = stoi(sargv.substr(6));
+            } else {
+                log.msg(WARN, "Invalid memo size in option " + sargv);
+            }
+        } else if (sargv == "-exactmath") {
+            // libm for all values of sin, exp ... in plist-float instead of the column approximations
+            exactMath = true;
+        } else if  (sargv.substr(0,9) == "-threads=") {
+            // number of threads executing the rows of a plist
+            if (b.isInt(sargv.substr(9))) {
+                threads = stoi(sargv.substr(9));
+            } else {
+                log.msg(WARN, "Invalid number of threads in option " + sargv);
+            }
         } else if  (sargv.substr(0,2) == "-d") {
             log.setLevel(DEBUG);
             debugtypes = sargv.substr(2);
@@ -161,6 +192,10 @@ int main(int argc, char *argv[])
 
        string currDirectory = b.getDir(filename);
        Interpreter ip = Interpreter(workDirectory, currDirectory, logOutput);
+       ip.setMaxDepth(maxDepth);
+       ip.setMaxMemo(maxMemo);
+       ip.setThreads(threads);
+       ip.setExactMath(exactMath);
        Preprocess pp = Preprocess();
 
        // do it
@@ -187,6 +222,10 @@ int main(int argc, char *argv[])
             if (retcode >= 0) {
                 retcode = p3.thirdParse(p2.getSentences());
                 if (debug_P) {log.debug("Third parse: " + p3.getContentString());};
+                if (retcode >= 0) {
+                    retcode = p4.fourthParse(p3.getParagraphs());
+                    if (debug_P) {log.debug("Fourth parse: " + p4.getContentString());};
+                }
             }
           }
         };
@@ -194,7 +233,7 @@ int main(int argc, char *argv[])
         if (retcode < 0) {
             log.msg(ERROR, "no execution because parsing failed.");
         } else if (ix >=3) {
-           ip.setParagraphs(p3.getParagraphs());
+           ip.setParagraphs(p4.getParagraphs());
            if (debug_I) {log.debug("Interpreter: " + ip.getNameList());};
            ip.execute(pargs);
         };
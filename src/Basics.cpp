@@ -38,7 +38,7 @@ Basics::~Basics()
     return s.find(c) != string::npos;
 }
 
-bool Basics::contains(string s, vector<string> v) {
+bool Basics::contains(const string &s, const vector<string> &v) {
         return find(v.begin(), v.end(), s) != v.end();
 }
 
@@ -188,7 +188,7 @@ string Basics::toLower(string text) {
 // ==================== vector ====================
 
 
-void Basics::addToVector(vector<string> &v, vector<string> &w) {
+void Basics::addToVector(vector<string> &v, const vector<string> &w) {
      for (int i = 0; i < (int) w.size(); ++i) {
         v.push_back(w[i]);
     }
@@ -200,7 +200,7 @@ void Basics::addToVectorP(vector<string>* v, vector<string>* w) {
     }
 }
 
-int Basics::countOcc(vector<string> &v, string search) {
+int Basics::countOcc(const vector<string> &v, string search) {
     int result = 0;
     for (int i=0;i<(int) v.size(); ++i) {
         if (v[i] == search){++result;}
@@ -208,7 +208,7 @@ int Basics::countOcc(vector<string> &v, string search) {
     return result;
 }
 
-string Basics::join(vector<string> &v, string sep) {
+string Basics::join(const vector<string> &v, string sep) {
     string result = "";
     int len = v.size();
     for (int i = 0; i < len; ++i) {
@@ -237,7 +237,7 @@ bool Basics::isEmpty(string text) {
 }
 
 //
-bool Basics::isInt(string text) {
+bool Basics::isInt(const string &text) {
     bool result = testInt(text);
     try {
         if (result) {
@@ -250,7 +250,7 @@ bool Basics::isInt(string text) {
     return result;
 }
 
-bool Basics::testInt(string text) {
+bool Basics::testInt(const string &text) {
     bool result = true;
     try {
         for (int i = 0; i < (int) text.length(); ++i) {
@@ -269,7 +269,7 @@ bool Basics::testInt(string text) {
     return result;
 }
 
-bool Basics::testNum(string text) {
+bool Basics::testNum(const string &text) {
     bool result = true;
     int dots = 0;
     int imax = text.length() - 1;
@@ -297,7 +297,7 @@ bool Basics::testNum(string text) {
 }
 
 
-bool Basics::isLong(string text) {
+bool Basics::isLong(const string &text) {
     bool result = testInt(text);
     try {
         if (result) {
@@ -310,7 +310,7 @@ bool Basics::isLong(string text) {
     return result;
 }
 
-bool Basics::isNumber(string text) {
+bool Basics::isNumber(const string &text) {
     bool result = isInt(text);
     if(result) {return true;}
     result = testNum(text);
@@ -385,7 +385,7 @@ vector<string>* Basics::readFileP(string name) {
    return v;
 }
 
-bool Basics::writeFile(string filename, vector<string> &v) {
+bool Basics::writeFile(string filename, const vector<string> &v) {
     fstream fs;
     bool result = false;
     try {
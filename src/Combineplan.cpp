@@ -0,0 +1,83 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "Combineplan.h"
+
+Combineplan::Combineplan(const vector<string> &v)
+{
+    uses = 0;
+    fors = 0;
+    withs = 0;
+    for (const string &text : v) {
+        if ((text.size() == 0) || (text[0] != '#')) {
+            slots.push_back('p');
+            plain.push_back(text);
+        } else if (text == "#u") {
+            slots.push_back('u');
+            ++uses;
+        } else if (text == "#f") {
+            slots.push_back('f');
+            ++fors;
+        } else if (text == "#w") {
+            slots.push_back('w');
+            ++withs;
+        }
+    }
+}
+
+Combineplan::~Combineplan()
+{
+    //dtor
+}
+
+// number of complete combinations, the combinations end when a list has not enough elements left
+// (-1 if the pattern takes nothing, then they only end by stop)
+long long int Combineplan::combinations(size_t uselen, size_t forlen, size_t withlen) const {
+    long long int n = -1;
+    if ((uses > 0) && ((n < 0) || ((long long int) uselen / uses < n))) {n = uselen / uses;}
+    if ((fors > 0) && ((n < 0) || ((long long int) forlen / fors < n))) {n = forlen / fors;}
+    if ((withs > 0) && ((n < 0) || ((long long int) withlen / withs < n))) {n = withlen / withs;}
+    return n;
+}
+
+// the parameters of combination c
+void Combineplan::build(long long int c, const List &uselist, const List &forlist, const List &withlist,
+                        vector<string> &row) const {
+    size_t u = c * uses;
+    size_t f = c * fors;
+    size_t w = c * withs;
+    size_t k = 0;
+    row.clear();
+    for (char slot : slots) {
+        switch (slot) {
+            case 'u':
+                row.push_back(uselist[u++]);
+                break;
+            case 'f':
+                row.push_back(forlist[f++]);
+                break;
+            case 'w':
+                row.push_back(withlist[w++]);
+                break;
+            default:
+                row.push_back(plain[k++]);
+        }
+    }
+}
@@ -0,0 +1,528 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Fourth.h"
+#include "Program.h"
+#include "Rowplan.h"
+#include "Combineplan.h"
+#include "globals.h"
+
+using namespace std;
+
+Fourth::Fourth()
+{
+    //ctor
+}
+
+Fourth::~Fourth()
+{
+    //dtor
+}
+
+int Fourth::fourthParse(vector<Paragraph> v) {
+    if (debug_P) {log.debug("fourth parse");}
+    int ok = 0;
+    paragraphs = v;
+    names.clear();
+    for (int i = 0; i < (int) paragraphs.size(); ++i) {
+        Paragraph &p = paragraphs[i];
+        if (!p.isHeader() && (p.getName().size() > 0)) {
+            names[p.getName()] = i;
+        }
+    }
+
+    for (int i = 0; i < (int) paragraphs.size(); ++i) {
+        if (linkVerbs(paragraphs[i]) < 0) {ok = -1;}
+        linkRefs(paragraphs[i]);
+        markTailCalls(paragraphs[i], i);
+        compilePrograms(paragraphs[i]);
+    }
+    if (ok == 0) {checkMemo();}
+    return ok;
+}
+
+// set the index of the called paragraph for every paragraph verb
+int Fourth::linkVerbs(Paragraph &p) {
+    int ok = 0;
+    for (int j = 0; j < p.getLength(); ++j) {
+        Item &item = p.getSentence(j).getVerb();
+        if (item.getVerbId() == V_PARAGRAPH) {
+            auto it = names.find(item.getName());
+            if (it != names.end()) {
+                item.setParaIndex(it->second);
+            } else {
+                log.msg(FATAL, "could not link verb " + item.getName() + " in paragraph " + p.getName());
+                ok = -1;
+            }
+            if (item.getReduce().size() > 0) {
+                it = names.find(item.getReduce());
+                if (it != names.end()) {
+                    item.setReduceIndex(it->second);
+                } else {
+                    log.msg(FATAL, "could not link reduce paragraph " + item.getReduce() + " in paragraph " + p.getName());
+                    ok = -1;
+                }
+            }
+        } else if (item.getVerbId() == V_NONE) {
+            log.msg(FATAL, "unknown verb " + item.getName() + " in paragraph " + p.getName());
+            ok = -1;
+        }
+    }
+    return ok;
+}
+
+// set the index of the referenced sentence for every sentence reference
+// and release every saved result after its last reader (jumps are always forward)
+void Fourth::linkRefs(Paragraph &p) {
+    int len = p.getLength();
+    vector<int> lastUse(len, -1);
+    for (int j = 0; j < len; ++j) {
+        Sentence &sentence = p.getSentence(j);
+        linkRefs(sentence.doparams, j, lastUse);
+        linkRefs(sentence.forparams, j, lastUse);
+        linkRefs(sentence.useparams, j, lastUse);
+        linkRefs(sentence.withparams, j, lastUse);
+    }
+    for (int k = 0; k < len; ++k) {
+        if (lastUse[k] >= 0) {p.getSentence(lastUse[k]).addRelease(k);}
+    }
+}
+
+void Fourth::linkRefs(vector<Item> &items, int sc, vector<int> &lastUse) {
+    for (int i = 0; i < (int) items.size(); ++i) {
+        Item &item = items[i];
+        if ((item.getTyp() == 'r') && (item.getRefSlot() == R_SENTENCE)) {
+            int refsc = sc - item.getRefdistance() - 1;
+            item.setRefSentence(refsc);
+            if ((refsc >= 0) && (refsc < (int) lastUse.size())) {lastUse[refsc] = sc;}
+        }
+    }
+}
+
+// mark every plain call of the own paragraph which is followed by "this returnValue." as last action,
+// such a call can reuse the frame of the calling paragraph
+void Fourth::markTailCalls(Paragraph &p, int index) {
+    int len = p.getLength();
+    for (int j = 0; j + 1 < len; ++j) {
+        Sentence &sentence = p.getSentence(j);
+        Item &item = sentence.getVerb();
+        if ((item.getVerbId() != V_PARAGRAPH) || (item.getParaIndex() != index) || (item.getVerbMode() != 0)
+            || item.hasEchoOut() || (sentence.getJump() != 1) || !isReturnOfThis(p.getSentence(j + 1))) {
+            continue;
+        }
+        // only end labels may follow until the end of the paragraph
+        int k = j + 1 + p.getSentence(j + 1).getJump();
+        while ((k > j) && (k < len) && isEmptyNop(p.getSentence(k)) && (p.getSentence(k).getJump() > 0)) {
+            k += p.getSentence(k).getJump();
+        }
+        if ((k > j) && (k >= len)) {
+            sentence.setTailCall();
+            if (debug_P) {log.debug("tail call of " + item.getName() + " in sentence " + to_string(j));}
+        }
+    }
+}
+
+bool Fourth::isReturnOfThis(Sentence &sentence) {
+    Item &item = sentence.getVerb();
+    if ((item.getVerbId() != V_RETURNVALUE) || (item.getParts().size() > 0) || (sentence.doparams.size() != 1)
+        || (sentence.forparams.size() > 0) || (sentence.useparams.size() > 0) || (sentence.withparams.size() > 0)) {
+        return false;
+    }
+    Item &param = sentence.doparams[0];
+    return (param.getTyp() == 'r') && (param.getRefSlot() == R_THIS) && (param.getRefKind() == RK_WHOLE);
+}
+
+// nop of an end label like "end)"
+bool Fourth::isEmptyNop(Sentence &sentence) {
+    Item &item = sentence.getVerb();
+    if ((item.getVerbId() != V_NOP) || (item.getParts().size() > 0) || (sentence.forparams.size() > 0)
+        || (sentence.useparams.size() > 0) || (sentence.withparams.size() > 0)) {
+        return false;
+    }
+    for (Item &param : sentence.doparams) {
+        if (param.getTyp() != 'c') {return false;}
+    }
+    return true;
+}
+
+// modifier memo is only kept for calls of pure paragraphs, i.e. paragraphs without in- or output
+// which only call pure paragraphs (the rows of perRow calls of pure paragraphs may run in parallel)
+void Fourth::checkMemo() {
+    int len = paragraphs.size();
+    vector<string> impure(len);
+    for (int i = 0; i < len; ++i) {
+        impure[i] = getImpureVerb(paragraphs[i]);
+        paragraphs[i].setReadsThis(readsCallerThis(paragraphs[i]));
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < len; ++i) {
+            if (impure[i].size() > 0) {continue;}
+            Paragraph &p = paragraphs[i];
+            for (int j = 0; j < p.getLength(); ++j) {
+                Item &item = p.getSentence(j).getVerb();
+                if ((item.getVerbId() == V_PARAGRAPH) && (impure[item.getParaIndex()].size() > 0)) {
+                    impure[i] = item.getName();
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < len; ++i) {
+        Paragraph &p = paragraphs[i];
+        p.setPure(impure[i].size() == 0);
+        for (int j = 0; j < p.getLength(); ++j) {
+            Item &item = p.getSentence(j).getVerb();
+            if (!item.hasMemo()) {continue;}
+            if (item.getVerbId() != V_PARAGRAPH) {
+                log.msg(WARN, "modifier memo is ignored for verb " + item.getName() + ".");
+                item.clearMemo();
+            } else if (impure[item.getParaIndex()].size() > 0) {
+                log.msg(WARN, "modifier memo is ignored for paragraph " + item.getName() + ", since it uses "
+                        + impure[item.getParaIndex()] + ".");
+                item.clearMemo();
+            }
+        }
+    }
+    checkParallel(impure);
+}
+
+// modifier parallel calls a paragraph for every chunk of its dolist, the chunks of an impure paragraph
+// are executed one after another
+void Fourth::checkParallel(vector<string> &impure) {
+    for (Paragraph &p : paragraphs) {
+        for (int j = 0; j < p.getLength(); ++j) {
+            Item &item = p.getSentence(j).getVerb();
+            if (item.getVerbMode() != 3) {
+                if ((item.getChunk() > 0) || (item.getReduce().size() > 0)) {
+                    log.msg(WARN, "modifiers chunk and reduce are ignored without modifier parallel for verb " + item.getName() + ".");
+                }
+            } else if (item.getVerbId() != V_PARAGRAPH) {
+                log.msg(WARN, "modifier parallel is ignored for verb " + item.getName() + ".");
+                item.clearParallel();
+            } else if (impure[item.getParaIndex()].size() > 0) {
+                log.msg(WARN, "modifier parallel executes the chunks of " + item.getName() + " one after another, since it uses "
+                        + impure[item.getParaIndex()] + ".");
+            }
+        }
+    }
+}
+
+// name of the first verb with in- or output, empty for a pure paragraph
+string Fourth::getImpureVerb(Paragraph &p) {
+    for (int j = 0; j < p.getLength(); ++j) {
+        Item &item = p.getSentence(j).getVerb();
+        switch (item.getVerbId()) {
+            case V_OUTPUT:
+            case V_PRINT:
+            case V_INPUT:
+            case V_FILE:
+            case V_READLINES:
+            case V_WRITELINES:
+            case V_TIME:
+                return item.getName();
+            default:
+                break;
+        }
+        if (item.hasEchoIn() || item.hasEchoOut()) {return "echo";}
+    }
+    return "";
+}
+
+// the this list of the caller is read if a sentence reads this before it has been set by the paragraph
+bool Fourth::readsCallerThis(Paragraph &p) {
+    for (int j = 0; j < p.getLength(); ++j) {
+        Sentence &sentence = p.getSentence(j);
+        if (readsThis(sentence.doparams) || readsThis(sentence.forparams) || readsThis(sentence.useparams)
+            || readsThis(sentence.withparams)) {
+            return true;
+        }
+        // nop and stop keep this unchanged
+        Verbs vid = sentence.getVerb().getVerbId();
+        if ((vid != V_NOP) && (vid != V_STOP)) {return false;}
+    }
+    return false;
+}
+
+bool Fourth::readsThis(vector<Item> &items) {
+    for (Item &item : items) {
+        if ((item.getTyp() == 'r') && (item.getRefSlot() == R_THIS)) {return true;}
+    }
+    return false;
+}
+
+string Fourth::getContentString() {
+    int len = paragraphs.size();
+    string result = "";
+    result = to_string(len ) + " paragraphs linked\n\n";
+    for (int i = 0; i < len; ++i) {
+        result += paragraphs[i].getContentString() + "\n";
+        result += "------------- PARAGRAPH END ------------\n\n";
+    }
+    return result;
+};
+
+vector<Paragraph> Fourth::getParagraphs() {
+    return paragraphs;
+}
+
+// compile the ops of plist, pexpr and cond and the patterns of perRow and combine once, if they are given by the sentence
+void Fourth::compilePrograms(Paragraph &p) {
+    for (int j = 0; j < p.getLength(); ++j) {
+        Sentence &sentence = p.getSentence(j);
+        Verbs vid = sentence.getVerb().getVerbId();
+        if (sentence.getVerb().getVerbMode() == 1) {
+            compileRowplan(sentence);
+        } else if (sentence.getVerb().getVerbMode() == 2) {
+            compileCombineplan(sentence);
+        }
+        if (((vid == V_PLIST) || (vid == V_PEXPR) || (vid == V_COND)) && (sentence.getVerb().getVerbMode() == 0)) {
+            compileProgram(sentence);
+        }
+        if ((vid == V_PEXPR) || (vid == V_COND)) {
+            fuse(sentence);
+        }
+    }
+    dispatch(p);
+}
+
+// references with a single value are set at run time, other references leave the sentence uncompiled
+void Fourth::compileProgram(Sentence &sentence) {
+    Item &verb = sentence.getVerb();
+    vector<Item> &items = sentence.doparams;
+    size_t from = 0;
+    if (verb.getVerbId() == V_COND) {
+        // the type of cond has to be known
+        if ((items.size() == 0) || (items[0].getTyp() != 'p')) {return;}
+        if ((items[0].getName() == "int") || (items[0].getName() == "float")) {from = 1;}
+    }
+    vector<string> ops;
+    vector<int> holes;
+    for (size_t i = from; i < items.size(); ++i) {
+        Item &item = items[i];
+        if (item.getTyp() == 'p') {
+            ops.push_back(item.getName());
+        } else if ((item.getTyp() == 'r') && ((item.getRefKind() == RK_INDEX) || (item.getRefKind() == RK_SIZE))) {
+            holes.push_back(ops.size());
+            ops.push_back("");
+        } else if (item.getTyp() == 'r') {
+            return;
+        }
+    }
+    if (ops.size() == 0) {return;}
+    shared_ptr<Program> program = make_shared<Program>();
+    try {
+        program->compile(ops, holes);
+    } catch (exception &e) {
+        // errors are reported at run time
+        return;
+    }
+    verb.setProgram(program);
+    if (debug_P) {log.debug("compiled " + to_string(ops.size()) + " ops of " + verb.getName());}
+}
+
+// a pattern given by references is parsed when executing
+void Fourth::compileRowplan(Sentence &sentence) {
+    vector<string> v;
+    for (Item &item : sentence.doparams) {
+        if (item.getTyp() == 'r') {return;}
+        if (item.getTyp() == 'p') {v.push_back(item.getName());}
+    }
+    Item &verb = sentence.getVerb();
+    shared_ptr<Rowplan> plan = make_shared<Rowplan>(v);
+    if ((verb.getVerbId() == V_PEXPR) && ((verb.getStype() == "long") || (verb.getStype() == "float"))) {
+        plan->compile();
+    }
+    verb.setRowplan(plan);
+    if (debug_P) {log.debug("compiled perRow pattern " + join(v, " ") + (plan->program ? " as program" : ""));}
+}
+
+void Fourth::compileCombineplan(Sentence &sentence) {
+    vector<string> v;
+    for (Item &item : sentence.doparams) {
+        if (item.getTyp() == 'r') {return;}
+        if (item.getTyp() == 'p') {v.push_back(item.getName());}
+    }
+    sentence.getVerb().setCombineplan(make_shared<Combineplan>(v));
+    if (debug_P) {log.debug("compiled combine pattern " + join(v, " "));}
+}
+
+// a pexpr-int or cond of plain values is computed now, a pexpr-int or cond of two operands (plain values or references
+// with a single value) and an operator like "params 1 -" or "params 0 ==" is evaluated by the interpreter without
+// building its ops, see Interpreter::execFused
+void Fourth::fuse(Sentence &sentence) {
+    Item &verb = sentence.getVerb();
+    Verbs vid = verb.getVerbId();
+    vector<Item> &items = sentence.doparams;
+    if ((verb.getVerbMode() != 0) || verb.hasEchoIn() || verb.hasForget() || (sentence.forparams.size() > 0)
+        || (sentence.useparams.size() > 0) || (sentence.withparams.size() > 0)) {return;}
+    char type = 'l';
+    size_t from = 0;
+    if (vid == V_PEXPR) {
+        if (verb.getStype() != "long") {return;}
+    } else if (vid == V_COND) {
+        // the type of cond is given by its first op
+        type = 's';
+        if ((items.size() > 0) && (items[0].getTyp() == 'p') && (items[0].getName() == "int")) {
+            type = 'l';
+            from = 1;
+        } else if ((items.size() > 0) && (items[0].getTyp() == 'p') && (items[0].getName() == "float")) {
+            type = 'd';
+            from = 1;
+        }
+    } else {
+        return;
+    }
+
+    Program *compiled = verb.getProgram();
+    if ((compiled != nullptr) && !compiled->hasHoles()) {
+        if (type == 'l') {
+            compiled->foldLong();
+        } else if (type == 's') {
+            compiled->foldValue();
+        }
+        if (compiled->folded && (vid == V_COND)) {
+            // the jump is decided by the first value like when executing, a value which is no int is reported then
+            try {
+                compiled->fulfilled = stoi(compiled->constant[0]) > 0;
+            } catch (exception &e) {
+                compiled->folded = false;
+            }
+        }
+        if (compiled->folded && debug_P) {log.debug("folded " + verb.getName() + " to " + join(compiled->constant.vec(), " "));}
+        return;
+    }
+
+    if ((items.size() != from + 3) || (items[from + 2].getTyp() != 'p')) {return;}
+    shared_ptr<Program> program = make_shared<Program>();
+    Program &prog = (compiled != nullptr) ? *compiled : *program;
+    Fused &fu = prog.fusion;
+    fu.type = type;
+    try {
+        Opcode op = prog.toOpcode(items[from + 2].getName(), from + 2);
+        long long int r;
+        bool b;
+        // a cond only uses comparisons and logical operators (which give 0 or 1)
+        bool test = Program::testDouble(op.op, 1, 1, b);
+        if ((op.operands != 2) || !(test || ((vid == V_PEXPR) && Program::applyLong(op.op, 1, 1, r)))) {return;}
+        fu.op = op.op;
+        int refs = 0;
+        for (int k = 0; k < 2; ++k) {
+            Item &item = items[from + k];
+            if ((item.getTyp() == 'r') && ((item.getRefKind() == RK_WHOLE) || (item.getRefKind() == RK_INDEX))) {
+                fu.ref[k] = from + k;
+                ++refs;
+                continue;
+            }
+            if (item.getTyp() != 'p') {return;}
+            Opcode value = prog.toOpcode(item.getName(), from + k);
+            if ((value.op != VAL) || ((type == 'l') && !value.hasLong) || ((type == 'd') && !value.hasDouble)) {return;}
+            fu.ref[k] = -1;
+            fu.lvalue[k] = value.lvalue;
+            fu.dvalue[k] = value.dvalue;
+            fu.svalue[k] = value.sleft;
+        }
+        if (refs == 0) {return;}
+    } catch (exception &e) {
+        // errors are reported at run time
+        return;
+    }
+    if (vid == V_COND) {
+        fu.yes = List(vector<string>{(type == 'd') ? to_string(1.0) : "1"});
+        fu.no = List(vector<string>{(type == 'd') ? to_string(0.0) : "0"});
+    }
+    prog.fused = true;
+    if (compiled == nullptr) {verb.setProgram(program);}
+    if (debug_P) {
+        string ops;
+        for (size_t i = from; i < items.size(); ++i) {
+            ops += " " + items[i].getName();
+        }
+        log.debug("fused " + verb.getName() + ops);
+    }
+}
+
+// a chain of at least three fused conds like "a) params~first 1 ==", "b) params~first 2 ==", ... where each false jump
+// leads to the next cond is decided by a single lookup of the value when executing its first cond.
+// The skipped conds would only set this to the same "0", so none of them may be saved or have an output.
+void Fourth::dispatch(Paragraph &p) {
+    int len = p.getLength();
+    vector<bool> linked(len, false);
+    for (int j = 0; j < len; ++j) {
+        if (linked[j] || !isCase(p.getSentence(j))) {continue;}
+        Sentence &head = p.getSentence(j);
+        Program &prog = *head.getVerb().getProgram();
+        Fused &fu = prog.fusion;
+        vector<int> chain;
+        int k = j;
+        while ((k < len) && isCase(p.getSentence(k))) {
+            Sentence &sentence = p.getSentence(k);
+            Fused &other = sentence.getVerb().getProgram()->fusion;
+            if ((chain.size() > 0) && ((other.type != fu.type) || (other.ref[0] != fu.ref[0])
+                || !isSameRef(sentence.doparams[other.ref[0]], head.doparams[fu.ref[0]]))) {break;}
+            chain.push_back(k);
+            k += sentence.getJump();
+        }
+        if (chain.size() < 3) {continue;}
+        Dispatch &d = prog.dispatch;
+        d.longs.clear();
+        d.doubles.clear();
+        d.strings.clear();
+        // the first of equal constants is fulfilled first
+        for (int m : chain) {
+            Fused &other = p.getSentence(m).getVerb().getProgram()->fusion;
+            int offset = m - j + 1;
+            if (fu.type == 'l') {
+                d.longs.emplace(other.lvalue[1], offset);
+            } else if (fu.type == 'd') {
+                d.doubles.emplace(other.dvalue[1], offset);
+            } else {
+                d.strings.emplace(other.svalue[1], offset);
+            }
+            linked[m] = true;
+        }
+        d.other = k - j;
+        d.length = chain.size();
+        prog.dispatched = true;
+        if (debug_P) {log.debug("dispatch of " + to_string(chain.size()) + " conds in sentence " + to_string(j));}
+    }
+}
+
+// fused cond "reference constant ==" without output, which jumps forward if not fulfilled
+bool Fourth::isCase(Sentence &sentence) {
+    Item &verb = sentence.getVerb();
+    Program *prog = verb.getProgram();
+    if ((verb.getVerbId() != V_COND) || (prog == nullptr) || !prog->fused || sentence.isSaved() || verb.hasEchoOut()
+        || verb.hasModInt() || verb.hasModFloat() || (sentence.getJump() <= 0)) {return false;}
+    Fused &fu = prog->fusion;
+    if ((fu.op != EQ) || (fu.ref[0] < 0) || (fu.ref[1] >= 0)) {return false;}
+    // this is changed by every cond
+    RefSlots slot = sentence.doparams[fu.ref[0]].getRefSlot();
+    return slot != R_THIS;
+}
+
+bool Fourth::isSameRef(Item &a, Item &b) {
+    if ((a.getRefSlot() != b.getRefSlot()) || (a.getRefKind() != b.getRefKind())) {return false;}
+    if ((a.getRefKind() == RK_INDEX) && (a.getRefFrom() != b.getRefFrom())) {return false;}
+    if ((a.getRefSlot() == R_NONE) || (a.getRefSlot() == R_SENTENCE)) {return a.getRefSentence() == b.getRefSentence();}
+    return true;
+}
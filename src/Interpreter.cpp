@@ -19,6 +19,7 @@ This file is part of the SOPL Interpreter.
 */
 
 #include "Interpreter.h"
+#include "Kernel.h"
 #include "globals.h"
 #include <iostream>
 #include <fstream>
@@ -29,6 +30,9 @@ This file is part of the SOPL Interpreter.
 #include <math.h>
 #include <filesystem>
 #include <map>
+#include <charconv>
+#include <string_view>
+#include <atomic>
 
 // could
 using namespace std;
@@ -37,6 +41,16 @@ Interpreter::Interpreter(string wdir, string cdir, bool pLogOutput)
 {
 
     stopExecution = 0;
+    depth = 0;
+    maxDepth = 0;
+    maxMemo = 0;
+    pool = make_shared<Pool>();
+    root = this;
+    outer = nullptr;
+    cancelled = false;
+    forkDepth = 0;
+    baseDepth = 0;
+    exactMath = false;
     logOutput = pLogOutput;
     groupNames = {"do", "for", "use", "with"};
     current = logg.getLevel();
@@ -53,12 +67,38 @@ Interpreter::Interpreter(string wdir, string cdir, bool pLogOutput)
     logg.msg(INFO, "Current directory is " + currDir);
 }
 
+// interpreter of a worker of a parallel perRow or of a call executed ahead, it executes the paragraphs of the main interpreter
+Interpreter::Interpreter(Interpreter *parent)
+{
+    stopExecution = 0;
+    depth = 0;
+    maxDepth = parent->maxDepth;
+    maxMemo = parent->maxMemo;
+    pool = parent->pool;
+    root = parent->root;
+    outer = parent;
+    cancelled = false;
+    forkDepth = parent->forkDepth;
+    baseDepth = 0;
+    exactMath = parent->exactMath;
+    logOutput = parent->logOutput;
+    groupNames = parent->groupNames;
+    current = parent->current;
+    workDir = parent->workDir;
+    currDir = parent->currDir;
+    progargs = parent->progargs;
+    paragraphs = parent->paragraphs;
+    names = parent->names;
+    memos.assign(paragraphs.size(), unordered_map<string, List>());
+}
+
 Interpreter::~Interpreter()
 {
 }
 
 void Interpreter::setParagraphs(vector<Paragraph> v) {
     paragraphs = v;
+    memos.assign(paragraphs.size(), unordered_map<string, List>());
     setNames();
 };
 
@@ -87,13 +127,15 @@ void Interpreter::setNames() {
 
 int Interpreter::execute(vector<string> &pargs) {
     if (current == FATAL ) {return -1;}
-    progargs = pargs;
-    vector<string> thislist;
-    vector<string> dolist;
-    vector<string> forlist;
-    vector<string> uselist;
-    vector<string> withlist;
-    execParagraph(0, thislist, dolist, forlist, uselist, withlist, 0);
+    progargs = List(pargs);
+    List thislist;
+    List dolist;
+    List forlist;
+    List uselist;
+    List withlist;
+    frames.clear();
+    depth = 0;
+    execParagraph(0, thislist, dolist, forlist, uselist, withlist, 0, false);
     return 0;
 }
 
@@ -105,111 +147,594 @@ string Interpreter::getNameList() {
     return result;
 }
 
-vector<string> Interpreter::execParagraph(int index, vector<string> &pthislist, vector<string> &pdolist, vector<string> &pforlist, vector<string> &puselist, vector<string> &pwithlist,
-                               int stackLevel) {
-    string hint = "begin";
+// call of a paragraph: it is executed on the frame stack, not on the native stack
+List Interpreter::execParagraph(int index, List &pthislist, List &pdolist, List &pforlist, List &puselist, List &pwithlist,
+                               int stackLevel, bool memo) {
     if (stopExecution > 0) {
         stopExecution = newStopExecution(stopExecution, PARAGRAPH);
         return pthislist;
     }
-    int offset=0;
-    vector<string> totalrv;
-    // needed as starting value for sentence loop
-    vector<string> outthislist=pthislist;
+    string key;
+    if (memo) {
+        key = getMemoKey(index, pthislist, pdolist, pforlist, puselist, pwithlist);
+        auto it = memos[index].find(key);
+        if (it != memos[index].end()) {return it->second;}
+    }
+    size_t base = depth;
+    if (!pushFrame(index, pthislist, pdolist, pforlist, puselist, pwithlist, stackLevel)) {
+        return pthislist;
+    }
+    if (memo) {
+        frames[depth - 1].memo = true;
+        frames[depth - 1].memoKey = move(key);
+    }
+    return run(base);
+}
+
+// the depth of the frame stack is only limited by memory or by option -depth=N
+// a frame left by an earlier call is reused together with the memory of its vectors
+bool Interpreter::pushFrame(int index, List &pthislist, List &pdolist, List &pforlist, List &puselist, List &pwithlist,
+                               int stackLevel) {
+    if ((maxDepth > 0) && ((int) depth >= maxDepth)) {
+        logg.msg(FATAL, "maximum call depth of " + to_string(maxDepth) + " exceeded when calling paragraph " + paragraphs[index].getName());
+        if (debug_y) {logg.debug("changed stop execution: " + to_string(stopExecution) + "->9");};
+        stopExecution = 9;
+        return false;
+    }
 
     if (debug_c) {logg.debug("entering Paragraph " + to_string(index) + " on level " + to_string(stackLevel));};
-    Paragraph p = paragraphs[index];
-    unordered_map<int, vector<string>> slists; //sentence result lists, will change
-    int scmax = p.getLength();
-    int sc= 0;
+    if (depth == frames.size()) {frames.emplace_back();}
+    Frame &f = frames[depth];
+    ++depth;
+    f.index = index;
+    f.sc = 0;
+    f.stackLevel = stackLevel;
+    f.waiting = false;
+    // needed as starting value for sentence loop
+    f.thislist = pthislist;
+    f.dolist = pdolist;
+    f.forlist = pforlist;
+    f.uselist = puselist;
+    f.withlist = pwithlist;
+    f.slists.resize(paragraphs[index].getLength());
+    f.totalrv.clear();
+    f.tailMark = -1;
+    f.memo = false;
+    return true;
+}
 
-    while (sc < scmax) {
-        Sentence sentence = p.getSentence(sc);
-        try {
-            hint = "preprocess";
-            vector<string> dolist;
-            vector<string> forlist;
-            vector<string> uselist;
-            vector<string> withlist;
-            hint = "do";
-            if (sentence.doparams.size() > 0) {dolist = getTheParam(sentence.doparams, sc,
-                outthislist, pdolist, pforlist, puselist, pwithlist, stackLevel, slists);}
-
-            hint = "for";
-
-            if (sentence.forparams.size() > 0) {forlist = getTheParam(sentence.forparams, sc,
-                 outthislist, pdolist, pforlist, puselist, pwithlist,  stackLevel, slists);}
-            hint = "use";
-
-            if (sentence.useparams.size() > 0) {uselist = getTheParam(sentence.useparams, sc,
-                 outthislist, pdolist, pforlist, puselist, pwithlist,  stackLevel, slists);}
-            hint = "with";
-
-            if (sentence.withparams.size() > 0) {withlist = getTheParam(sentence.withparams, sc,
-                 outthislist, pdolist, pforlist, puselist, pwithlist,  stackLevel, slists);}
-
-            hint = "execVerb";
-            Item item = sentence.getLastItem();
-
-            if (item.hasForget()) {
-                //int before = mmemsize(slists) + vmemsize(pdolist) + vmemsize(pforlist) + vmemsize(puselist) + vmemsize(pwithlist) + vmemsize(pthislist) + vmemsize(totalrv);
-                //logg.debug("c", "executing forget in paragraph " + to_string(index));
-                slists.clear();
-                pdolist.clear();pdolist.shrink_to_fit();
-                pforlist.clear();pforlist.shrink_to_fit();
-                puselist.clear();puselist.shrink_to_fit();
-                pwithlist.clear();pwithlist.shrink_to_fit();
-                //int after = mmemsize(slists) + vmemsize(pdolist) + vmemsize(pforlist) + vmemsize(puselist) + vmemsize(pwithlist) + vmemsize(pthislist) + vmemsize(totalrv);
-                //logg.debug("c", "before: " + to_string(before) + ", after: " + to_string(after));
+// the lists of the frame are released at once, the frame itself is kept for the next call
+void Interpreter::popFrame() {
+    Frame &f = frames[depth - 1];
+    f.thislist.clear();
+    f.dolist.clear();
+    f.forlist.clear();
+    f.uselist.clear();
+    f.withlist.clear();
+    releaseSlists(f.slists);
+    f.memoKey.clear();
+    if (f.ahead.sc >= 0) {f.ahead = Ahead();}
+    --depth;
+    // keep only a limited number of unused frames after deep recursions
+    if (frames.size() > depth + FRAME_POOL) {frames.pop_back();}
+}
+
+// tail call of the own paragraph: the frame is restarted with the new parameters,
+// the values returned so far stay in totalrv as the call's result is only appended to them
+void Interpreter::reuseFrame(Frame &f, List &pdolist, List &pforlist, List &puselist, List &pwithlist) {
+    if (debug_c) {logg.debug("reentering Paragraph " + to_string(f.index) + " on level " + to_string(f.stackLevel));};
+    f.sc = 0;
+    f.dolist = pdolist;
+    f.forlist = pforlist;
+    f.uselist = puselist;
+    f.withlist = pwithlist;
+    releaseSlists(f.slists);
+    if (f.ahead.sc >= 0) {f.ahead = Ahead();}
+    f.tailMark = f.totalrv.size();
+}
+
+// execute the frames above base until the paragraph of frame base has returned
+List Interpreter::run(size_t base) {
+    List result;
+    while (depth > base) {
+        Frame &f = frames[depth - 1];
+        if ((outer != nullptr) && (stopExecution != 9) && isCancelled()) {
+            // the paragraphs of a call executed ahead, whose result is not needed any more, are left at once
+            stopExecution = 9;
+        }
+        if (f.sc < paragraphs[f.index].getLength()) {
+            execSentence(f);
+        } else {
+            if (debug_c) {logg.debug("leaving Paragraph " + to_string(f.index));};
+            stopExecution = newStopExecution(stopExecution, PARAGRAPH);
+            if ((stopExecution > 0) && (f.tailMark >= 0)) {
+                // stop paragraph also stops the paragraph which made the last tail call,
+                // it returns only the values collected before that call
+                f.totalrv.resize(f.tailMark);
+                stopExecution = newStopExecution(stopExecution, PARAGRAPH);
+            }
+            result = List(move(f.totalrv));
+            if (f.memo && (stopExecution == 0)) {storeMemo(f.index, f.memoKey, result);}
+            popFrame();
+            if (depth > base) {
+                returnToCaller(frames[depth - 1], result);
+            }
+        }
+    }
+    return result;
+}
+
+// execute the current sentence of a frame, a paragraph call only pushes the frame of the called paragraph
+void Interpreter::execSentence(Frame &f) {
+    Sentence &sentence = paragraphs[f.index].getSentence(f.sc);
+    string hint = "begin";
+    int offset=0;
+    try {
+        hint = "fused";
+        Program *program = sentence.getVerb().getProgram();
+        if ((program != nullptr) && (program->folded || program->fused)) {
+            List p;
+            if (execFused(f, sentence, *program, p, offset)) {
+                Item &item = sentence.getVerb();
+                beginVerb(item, p);
+                endVerb(item, p);
+                f.thislist = p;
+                if (sentence.isSaved()) {
+                    f.slists[f.sc].list = f.thislist;
+                    f.slists[f.sc].valid = true;
+                }
+                nextSentence(f, offset);
+                return;
             }
+        }
+        hint = "preprocess";
+        List dolist;
+        List forlist;
+        List uselist;
+        List withlist;
+        hint = "do";
+        if (sentence.doparams.size() > 0) {dolist = getTheParam(sentence.doparams, f.sc,
+            f.thislist, f.dolist, f.forlist, f.uselist, f.withlist, f.stackLevel, f.slists);}
+
+        hint = "for";
+
+        if (sentence.forparams.size() > 0) {forlist = getTheParam(sentence.forparams, f.sc,
+             f.thislist, f.dolist, f.forlist, f.uselist, f.withlist, f.stackLevel, f.slists);}
+        hint = "use";
+
+        if (sentence.useparams.size() > 0) {uselist = getTheParam(sentence.useparams, f.sc,
+             f.thislist, f.dolist, f.forlist, f.uselist, f.withlist, f.stackLevel, f.slists);}
+        hint = "with";
+
+        if (sentence.withparams.size() > 0) {withlist = getTheParam(sentence.withparams, f.sc,
+             f.thislist, f.dolist, f.forlist, f.uselist, f.withlist, f.stackLevel, f.slists);}
+
+        hint = "execVerb";
+        Item &item = sentence.getVerb();
+
+        if (item.hasForget()) {
+            releaseSlists(f.slists);
+            f.dolist.clear();
+            f.forlist.clear();
+            f.uselist.clear();
+            f.withlist.clear();
+        }
+
+        if ((item.getVerbId() == V_PARAGRAPH) && (item.getVerbMode() == 0)) {
+            // plain paragraph call, the sentence is finished in returnToCaller
+            beginVerb(item, dolist);
+            int index = item.getParaIndex();
+            string key;
+            if ((stopExecution == 0) && item.hasMemo()) {
+                key = getMemoKey(index, f.thislist, dolist, forlist, uselist, withlist);
+                auto it = memos[index].find(key);
+                if (it != memos[index].end()) {
+                    List p = it->second;
+                    returnToCaller(f, p);
+                    return;
+                }
+            }
+            if (stopExecution > 0) {
+                stopExecution = newStopExecution(stopExecution, PARAGRAPH);
+            } else if ((f.ahead.sc == f.sc) && takeAhead(f, dolist, forlist, uselist, withlist)) {
+                return;
+            } else if (sentence.isTailCall()) {
+                reuseFrame(f, dolist, forlist, uselist, withlist);
+                return;
+            } else if (executeAhead(f, dolist, forlist, uselist, withlist)) {
+                return;
+            } else if (pushFrame(index, f.thislist, dolist, forlist, uselist, withlist, f.stackLevel + 1)) {
+                if (item.hasMemo()) {
+                    frames[depth - 1].memo = true;
+                    frames[depth - 1].memoKey = move(key);
+                }
+                return;
+            }
+            // not called
+            List p = f.thislist;
+            returnToCaller(f, p);
+            return;
+        }
 
-            tie(offset, outthislist) = executeVerb(item, sentence.getJump(), outthislist, dolist, forlist, uselist, withlist, stackLevel);
+        tie(offset, f.thislist) = executeVerb(item, sentence.getJump(), f.thislist, dolist, forlist, uselist, withlist, f.stackLevel);
 
-            hint = "addRV";
-            if (item.getName() == "returnValue") {addToVector(totalrv, outthislist);};
+        hint = "addRV";
+        if (item.getVerbId() == V_RETURNVALUE) {f.totalrv.insert(f.totalrv.end(), f.thislist.begin(), f.thislist.end());};
 
-            hint = "isSaved";
-            if (sentence.isSaved()) {
-                slists[sentence.getSeq()] = outthislist;
+        hint = "isSaved";
+        if (sentence.isSaved()) {
+            f.slists[f.sc].list = f.thislist;
+            f.slists[f.sc].valid = true;
+        }
+    } catch (exception& e) {
+        sentenceError(f, e, hint);
+    }
+
+    nextSentence(f, offset);
+}
+
+// pexpr-int or cond computed or fused by the fourth parse, false if the sentence has to be executed as usual
+// (which then also reports the errors)
+bool Interpreter::execFused(Frame &f, Sentence &sentence, Program &prog, List &p, int &offset) {
+    bool cond = (sentence.getVerb().getVerbId() == V_COND);
+    offset = sentence.getJump();
+    if (prog.folded) {
+        p = prog.constant;
+        // condition fulfilled => goto next
+        if (cond && prog.fulfilled) {offset = 1;}
+        return true;
+    }
+    if (debug_r || debug_b) {return false;}
+    const Fused &fu = prog.fusion;
+    const List *list[2] = {nullptr, nullptr};
+    int index[2] = {0, 0};
+    for (int k = 0; k < 2; ++k) {
+        if ((fu.ref[k] >= 0) && !getFusedOperand(f, sentence.doparams[fu.ref[k]], list[k], index[k])) {return false;}
+    }
+    bool fulfilled = false;
+    try {
+        if (fu.type == 'l') {
+            long long int v[2];
+            long long int r;
+            for (int k = 0; k < 2; ++k) {
+                v[k] = list[k] ? list[k]->getLong(index[k]) : fu.lvalue[k];
             }
-        } catch (exception& e) {
-            string s(e.what());
-            logg.msg(FATAL, s + " in sentence " + to_string(sc) + " of paragraph " + p.getName() + " at level " + to_string(stackLevel));
-            logg.msg(FATAL, "error occured when executing " + sentence.getLastItem().getName() + " - hint: " + hint);
-            if (debug_y) {logg.debug("changed stop execution: " + to_string(stopExecution) + "->9");};
-            stopExecution = 9;
+            if (prog.dispatched && !debug_s) {
+                auto it = prog.dispatch.longs.find(v[0]);
+                return dispatchTo(prog, (it != prog.dispatch.longs.end()) ? it->second : 0, p, offset);
+            }
+            if (!Program::applyLong(fu.op, v[0], v[1], r)) {return false;}
+            if (!cond) {
+                p = List(vector<string>{to_string(r)}, vector<long long int>{r});
+                return true;
+            }
+            fulfilled = (r > 0);
+        } else if (fu.type == 'd') {
+            double v[2];
+            for (int k = 0; k < 2; ++k) {
+                v[k] = list[k] ? list[k]->getDouble(index[k]) : fu.dvalue[k];
+            }
+            if (prog.dispatched && !debug_s) {
+                auto it = prog.dispatch.doubles.find(v[0]);
+                return dispatchTo(prog, (it != prog.dispatch.doubles.end()) ? it->second : 0, p, offset);
+            }
+            if (!Program::testDouble(fu.op, v[0], v[1], fulfilled)) {return false;}
+        } else {
+            const string *v[2];
+            for (int k = 0; k < 2; ++k) {
+                v[k] = list[k] ? &(*list[k])[index[k]] : &fu.svalue[k];
+                // a value like "+" or "var1" would be an opcode
+                if (list[k] && !prog.isPlainValue(*v[k])) {return false;}
+            }
+            // the type of the cond is given by its first value
+            if (list[0] && ((*v[0] == "int") || (*v[0] == "float"))) {return false;}
+            if (prog.dispatched && !debug_s) {
+                auto it = prog.dispatch.strings.find(*v[0]);
+                return dispatchTo(prog, (it != prog.dispatch.strings.end()) ? it->second : 0, p, offset);
+            }
+            if (!prog.testString(fu.op, *v[0], *v[1], fulfilled)) {return false;}
         }
+    } catch (exception &e) {
+        return false;
+    }
+    p = fulfilled ? fu.yes : fu.no;
+    if (fulfilled) {offset = 1;}
+    return true;
+}
+
+// result of a chain of conds, the offset of the sentence after the fulfilled cond or 0 if none is fulfilled
+bool Interpreter::dispatchTo(Program &prog, int found, List &p, int &offset) {
+    p = (found > 0) ? prog.fusion.yes : prog.fusion.no;
+    offset = (found > 0) ? found : prog.dispatch.other;
+    return true;
+}
+
+// list and index of a reference to a single value, false for anything else
+bool Interpreter::getFusedOperand(Frame &f, Item &item, const List *&list, int &index) {
+    RefSlots slot = item.getRefSlot();
+    if ((slot == R_NONE) || (slot == R_SENTENCE)) {
+        int key = item.getRefSentence();
+        if ((key < 0) || (key >= (int) f.slists.size()) || !f.slists[key].valid) {return false;}
+    }
+    List &l = getRefList(item, f.thislist, f.dolist, f.forlist, f.uselist, f.withlist, f.slists);
+    index = 0;
+    if (item.getRefKind() == RK_INDEX) {
+        index = item.getRefFrom();
+        if (index < 0) {index = l.size() + index;}
+    } else if (l.size() != 1) {
+        return false;
+    }
+    if ((index < 0) || (index >= (int) l.size())) {return false;}
+    list = &l;
+    return true;
+}
 
-        if ((stopExecution >0) || (offset <= - 1000)) {break;}
-        sc+= offset;
+// the paragraph called by the current sentence of the frame has returned
+void Interpreter::returnToCaller(Frame &f, List &result) {
+    Sentence &sentence = paragraphs[f.index].getSentence(f.sc);
+    string hint = "return";
+    try {
+        Item &item = sentence.getVerb();
+        if (debug_c) {logg.debug("RV=" + join(result.vec(), " "));};
+        endVerb(item, result);
+        f.thislist = result;
+
+        hint = "isSaved";
+        if (sentence.isSaved()) {
+            f.slists[f.sc].list = f.thislist;
+            f.slists[f.sc].valid = true;
+        }
+    } catch (exception& e) {
+        sentenceError(f, e, hint);
     }
 
-    if (debug_c) {logg.debug("leaving Paragraph " + to_string(index));};
-    stopExecution = newStopExecution(stopExecution, PARAGRAPH);
-    return totalrv;
+    nextSentence(f, sentence.getJump());
 }
 
-vector<string> Interpreter::getTheParam(vector<Item> &items, int sc, vector<string> &thislist, vector<string> &dolist, vector<string> &forlist, vector<string> &uselist, vector<string> &withlist,
-           int stackLevel, unordered_map<int, vector<string>> &slists) {
-    vector<string> result;
+void Interpreter::nextSentence(Frame &f, int offset) {
+    Paragraph &p = paragraphs[f.index];
+    int scmax = p.getLength();
+    if ((stopExecution >0) || (offset <= - 1000)) {
+        // leave paragraph
+        f.sc = scmax;
+        return;
+    }
+    // results not read by any later sentence (incl. the skipped ones) are released
+    for (int i = f.sc; (i < f.sc + offset) && (i < scmax); ++i) {
+        releaseSlists(f.slists, p.getSentence(i).getReleases());
+    }
+    f.sc+= offset;
+}
+
+// a later sentence of the straight sequence after the current paragraph call, which calls a pure paragraph
+// without reading this or the results of the sentences in between, -1 if there is none or no thread is idle.
+// Only the calls near the top of the stack are executed ahead, the deeper ones are too small for another thread.
+int Interpreter::findAhead(Frame &f) {
+    if ((baseDepth + depth >= forkDepth) || (maxDepth > 0)) {return -1;}
+    Paragraph &p = paragraphs[f.index];
+    Sentence &current = p.getSentence(f.sc);
+    if ((current.getJump() != 1) || current.getVerb().hasMemo()) {return -1;}
+    for (int k = f.sc + 1; k < p.getLength(); ++k) {
+        Sentence &sentence = p.getSentence(k);
+        if (isForkable(sentence)) {
+            return (!dependsOn(sentence, f.sc, k) && pool->hasIdle()) ? k : -1;
+        }
+        if ((sentence.getJump() != 1) || sentence.getVerb().hasForget()) {return -1;}
+    }
+    return -1;
+}
+
+// plain call of a pure paragraph, which does not read the this list of the caller
+// (a tail call executed ahead returns its result like any other call, this returnValue then appends it)
+bool Interpreter::isForkable(Sentence &sentence) {
+    Item &item = sentence.getVerb();
+    if ((item.getVerbId() != V_PARAGRAPH) || (item.getVerbMode() != 0) || item.hasMemo() || item.hasForget()) {
+        return false;
+    }
+    Paragraph &p = paragraphs[item.getParaIndex()];
+    return p.isPure() && !p.readsThis();
+}
+
+// true if the parameters of the sentence read this or the result of one of the sentences from..to-1
+bool Interpreter::dependsOn(Sentence &sentence, int from, int to) {
+    for (vector<Item> *items : {&sentence.doparams, &sentence.forparams, &sentence.useparams, &sentence.withparams}) {
+        for (Item &item : *items) {
+            if (item.getTyp() != 'r') {continue;}
+            RefSlots slot = item.getRefSlot();
+            if (slot == R_THIS) {return true;}
+            if (((slot == R_NONE) || (slot == R_SENTENCE)) && (item.getRefSentence() >= from) && (item.getRefSentence() < to)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// the call of the current sentence and the call of the later sentence found by findAhead are executed at the same
+// time, the later one by a helper with its messages kept in the frame until its sentence is reached.
+// False if nothing was executed (the later parameters are only evaluated if this gives no message).
+bool Interpreter::executeAhead(Frame &f, List &dolist, List &forlist, List &uselist, List &withlist) {
+    int k = findAhead(f);
+    if (k < 0) {return false;}
+    Sentence &later = paragraphs[f.index].getSentence(k);
+    Ahead a;
+    vector<pair<Level, string>> *capture = Log::capture;
+    Log::capture = &a.messages;
+    if (later.doparams.size() > 0) {a.dolist = getTheParam(later.doparams, k,
+        f.thislist, f.dolist, f.forlist, f.uselist, f.withlist, f.stackLevel, f.slists);}
+    if (later.forparams.size() > 0) {a.forlist = getTheParam(later.forparams, k,
+        f.thislist, f.dolist, f.forlist, f.uselist, f.withlist, f.stackLevel, f.slists);}
+    if (later.useparams.size() > 0) {a.uselist = getTheParam(later.useparams, k,
+        f.thislist, f.dolist, f.forlist, f.uselist, f.withlist, f.stackLevel, f.slists);}
+    if (later.withparams.size() > 0) {a.withlist = getTheParam(later.withparams, k,
+        f.thislist, f.dolist, f.forlist, f.uselist, f.withlist, f.stackLevel, f.slists);}
+    Log::capture = capture;
+    if (!a.messages.empty()) {
+        stopExecution = 0;
+        return false;
+    }
+
+    unique_ptr<Interpreter> helper = takeSpare();
+    helper->stopExecution = 0;
+    helper->baseDepth = baseDepth + depth;
+    int index = paragraphs[f.index].getSentence(f.sc).getVerb().getParaIndex();
+    int laterIndex = later.getVerb().getParaIndex();
+    List thislist = f.thislist;
+    List none;
+    List result;
+    pool->run(2, [&](int c) {
+        vector<pair<Level, string>> *previous = Log::capture;
+        bool concurrent = List::concurrent;
+        List::concurrent = true;
+        if (c == 0) {
+            Log::capture = capture;
+            result = execParagraph(index, thislist, dolist, forlist, uselist, withlist, f.stackLevel + 1, false);
+            // the later sentence is not reached after a stop
+            if (stopExecution > 0) {helper->cancelled = true;}
+        } else {
+            Log::capture = &a.messages;
+            a.result = helper->execParagraph(laterIndex, none, a.dolist, a.forlist, a.uselist, a.withlist,
+                                             f.stackLevel + 1, false);
+            a.stop = helper->stopExecution;
+        }
+        Log::capture = previous;
+        List::concurrent = concurrent;
+    });
+    releaseSpare(move(helper));
+
+    a.sc = k;
+    f.ahead = move(a);
+    returnToCaller(f, result);
+    return true;
+}
+
+// the call of the current sentence was executed ahead, its result is taken if the parameters are still the same
+bool Interpreter::takeAhead(Frame &f, List &dolist, List &forlist, List &uselist, List &withlist) {
+    Ahead a;
+    swap(a, f.ahead);
+    if ((a.dolist.vec() != dolist.vec()) || (a.forlist.vec() != forlist.vec()) || (a.uselist.vec() != uselist.vec())
+        || (a.withlist.vec() != withlist.vec())) {
+        return false;
+    }
+    for (const pair<Level, string> &m : a.messages) {logg.msg(m.first, m.second);}
+    stopExecution = a.stop;
+    returnToCaller(f, a.result);
+    return true;
+}
+
+bool Interpreter::isCancelled() {
+    for (Interpreter *i = this; i != nullptr; i = i->outer) {
+        if (i->cancelled.load(memory_order_relaxed)) {return true;}
+    }
+    return false;
+}
+
+// the helpers of calls executed ahead are kept by the root interpreter for the next call
+unique_ptr<Interpreter> Interpreter::takeSpare() {
+    unique_ptr<Interpreter> helper;
+    {
+        lock_guard<mutex> lock(root->spareLock);
+        if (!root->spares.empty()) {
+            helper = move(root->spares.back());
+            root->spares.pop_back();
+        }
+    }
+    if (!helper) {helper.reset(new Interpreter(this));}
+    helper->outer = this;
+    helper->cancelled = false;
+    return helper;
+}
+
+void Interpreter::releaseSpare(unique_ptr<Interpreter> helper) {
+    lock_guard<mutex> lock(root->spareLock);
+    root->spares.push_back(move(helper));
+}
+
+void Interpreter::sentenceError(Frame &f, exception &e, string hint) {
+    Paragraph &p = paragraphs[f.index];
+    string s(e.what());
+    logg.msg(FATAL, s + " in sentence " + to_string(f.sc) + " of paragraph " + p.getName() + " at level " + to_string(f.stackLevel));
+    logg.msg(FATAL, "error occured when executing " + p.getSentence(f.sc).getLastItem().getName() + " - hint: " + hint);
+    if (debug_y) {logg.debug("changed stop execution: " + to_string(stopExecution) + "->9");};
+    stopExecution = 9;
+}
+
+void Interpreter::setMaxDepth(int depth) {
+    maxDepth = depth;
+}
+
+void Interpreter::setMaxMemo(int size) {
+    maxMemo = size;
+}
+
+// calls are executed ahead on the upper 2 * log2(N) + FORK_LEVELS levels of the stack, which gives enough calls
+// for N threads, the deeper calls are too small to be worth another thread
+void Interpreter::setThreads(int n) {
+    pool->setThreads(n);
+    forkDepth = (n > 1) ? 2 * (size_t) ceil(log2(n)) + FORK_LEVELS : 0;
+}
+
+void Interpreter::setExactMath(bool exact) {
+    exactMath = exact;
+}
+
+// the result of a pure paragraph only depends on its parameters (and on this, if it is read)
+string Interpreter::getMemoKey(int index, List &pthislist, List &pdolist, List &pforlist, List &puselist, List &pwithlist) {
+    string key;
+    if (paragraphs[index].readsThis()) {addMemoKey(key, pthislist);}
+    key.push_back('|');
+    addMemoKey(key, pdolist);
+    addMemoKey(key, pforlist);
+    addMemoKey(key, puselist);
+    addMemoKey(key, pwithlist);
+    return key;
+}
+
+// every element is preceded by its length, so that different lists never give the same key
+void Interpreter::addMemoKey(string &key, List &list) {
+    key += to_string(list.size());
+    key.push_back(';');
+    for (int i = 0; i < (int) list.size(); ++i) {
+        const string &s = list[i];
+        key += to_string(s.size());
+        key.push_back(':');
+        key += s;
+    }
+}
+
+// a full cache is cleared, so that it keeps the recent results
+void Interpreter::storeMemo(int index, string &key, List &result) {
+    unordered_map<string, List> &memo = memos[index];
+    if ((maxMemo > 0) && ((int) memo.size() >= maxMemo)) {
+        if (debug_c) {logg.debug("clearing memo of Paragraph " + to_string(index));};
+        memo.clear();
+    }
+    memo[key] = result;
+}
+
+List Interpreter::getTheParam(vector<Item> &items, int sc, List &thislist, List &dolist, List &forlist, List &uselist, List &withlist,
+           int stackLevel, vector<Slist> &slists) {
+    List result;
     string hint = "begin";
 
     try {
-        vector<string> help;
+        List help;
         int len = items.size();
 
         for (int i = 0; i < len; ++i) {
-            Item item = items[i];
+            Item &item = items[i];
             char typ = item.getTyp();
             hint = "item " + to_string(i) + " of typ " + ctos(typ);
 
             if (typ == 'p') {
-                result.push_back(item.getName());
+                result.push(item.getName());
             } else if (typ == 'r') {
-               help.clear();
-               help = getTheReference(item, sc, thislist, dolist, forlist, uselist, withlist, slists);
-               if (debug_r) {logg.debug("ref " + item.getName() + " evaluated to " + join(help, ","));};
-               addToVector(result, help);
+               help = getTheReference(item, thislist, dolist, forlist, uselist, withlist, slists);
+               if (debug_r) {logg.debug("ref " + item.getName() + " evaluated to " + join(help.vec(), ","));};
+               // a single reference is passed on without copying
+               if (len == 1) {return help;}
+               // values already known for the referenced list are kept
+               result.append(help);
             } else if ((typ == 'l') || (typ == 'g') || (typ == 'n') || (typ == 'l')|| (typ == 'v')|| (typ == 'c')) {
                 // ignore
 
@@ -228,254 +753,222 @@ vector<string> Interpreter::getTheParam(vector<Item> &items, int sc, vector<stri
     return result;
 }
 
-vector<string> Interpreter::getTheReference(Item item, int sc, vector<string> &thislist, vector<string> &dolist, vector<string> &forlist, vector<string> &uselist, vector<string> &withlist,
-                             unordered_map<int, vector<string>> &slists) {
+List Interpreter::getTheReference(Item &item, List &thislist, List &dolist, List &forlist, List &uselist, List &withlist,
+                             vector<Slist> &slists) {
     vector<string> result;
-    string name = item.getName();
-    //string help = "";
     int refFrom = item.getRefFrom();
     int refTo = item.getRefTo();
     int ihelp = 0;
     try {
-        // clumsy but (hopefully) faster
-        if (item.hasGetSize()) {
-            if (name == "this") {
-                ihelp = thislist.size();
-            } else if (name == "params") {
-                ihelp = dolist.size();
-            } else if (name == "forparams") {
-                ihelp = forlist.size();
-            } else if (name == "useparams") {
-                ihelp = uselist.size();
-            } else if (name == "withparams") {
-                ihelp = withlist.size();
-            } else if (name == "args") {
-                ihelp = progargs.size();
-            }else {
-                int refsc = item.getRefdistance() + 1;
-                refsc = sc - refsc;
-                ihelp= getSlist(slists, refsc).size();
-            }
-            ihelp = ihelp + refTo - refFrom + 1;
-            result.push_back(to_string(ihelp));
-        // not modified => use original
-        } else if ((refFrom == 0) && (refTo == -1)) {
-            if (name == "this") {
-                return thislist;
-            } else if (name == "params") {
-                return dolist;
-            } else if (name == "forparams") {
-                return forlist;
-            } else if (name == "useparams") {
-                return uselist;
-            } else if (name == "withparams") {
-                return withlist;
-            } else if (name == "args") {
-                return progargs;
-            }else {
-                int refsc = item.getRefdistance() + 1;
-                refsc = sc - refsc;
-                return getSlist(slists, refsc);
-            }
-          // index
-        } else if (refFrom == refTo) {
-            ihelp = refFrom;
-
-            if (name == "this") {
-                if (ihelp<0) {ihelp = thislist.size() + ihelp;}
-                result.push_back(thislist.at(ihelp));
-            } else if (name == "params") {
-                if (ihelp<0) {ihelp = dolist.size() + ihelp;}
-                result.push_back(dolist.at(ihelp));
-            } else if (name == "forparams") {
-                if (ihelp<0) {ihelp = forlist.size() + ihelp;}
-                result.push_back(forlist.at(ihelp));
-            } else if (name == "useparams") {
-                if (ihelp<0) {ihelp = uselist.size() + ihelp;}
-                result.push_back(uselist.at(ihelp));
-            } else if (name == "withparams") {
-                if (ihelp<0) {ihelp = withlist.size() + ihelp;}
-                result.push_back(withlist.at(ihelp));
-            } else if (name == "args") {
-                if (ihelp<0) {ihelp = progargs.size() + ihelp;}
-                result.push_back(progargs.at(ihelp));
-            } else {
-                int refsc = item.getRefdistance() + 1;
-                refsc = sc - refsc;
-                if (ihelp<0) {
-                    ihelp = getSlist(slists, refsc).size() + ihelp;
+        // slot and kind of the reference were set when creating the item
+        List &list = getRefList(item, thislist, dolist, forlist, uselist, withlist, slists);
+        switch (item.getRefKind()) {
+            case RK_SIZE:
+                ihelp = list.size() + refTo - refFrom + 1;
+                result.push_back(to_string(ihelp));
+                break;
+            // not modified => use original
+            case RK_WHOLE:
+                return list;
+            case RK_INDEX:
+                ihelp = refFrom;
+                if (ihelp<0) {ihelp = list.size() + ihelp;}
+                result.push_back(list.at(ihelp));
+                break;
+            // range is a view on the original, no copy
+            case RK_RANGE: {
+                int from = (refFrom > 0) ? refFrom : 0;
+                ihelp = list.size() + refTo + 1;
+                if (from < ihelp) {
+                    return list.slice(from, ihelp);
                 }
-                result.push_back(getSlist(slists, refsc).at(ihelp));
-            }
-          // construct range here
-        } else {
-             if (name == "this") {
-                result = thislist;
-            } else if (name == "params") {
-                result = dolist;
-            } else if (name == "forparams") {
-                result = forlist;
-            } else if (name == "useparams") {
-                result = uselist;
-            } else if (name == "withparams") {
-                result = withlist;
-            } else if (name == "args") {
-                result = progargs;
-            } else {
-                int refsc = item.getRefdistance() + 1;
-                refsc = sc - refsc;
-                result = getSlist(slists, refsc);
-            }
-            if (refFrom > 0) {
-                result.erase(result.begin(), result.begin() + refFrom);
-            }
-
-            if (refTo < -1) {
-                for (int i = 1; i < abs(refTo); ++i) {result.pop_back();}
+                break;
             }
         }
     } catch (exception& e) {
-        logg.msg(FATAL, cstos(e.what()) + ": when processing ref.+modifiers for " + name + "[" + to_string(refFrom) + ".." + to_string(refTo) + "]");
+        logg.msg(FATAL, cstos(e.what()) + ": when processing ref.+modifiers for " + item.getName() + "[" + to_string(refFrom) + ".." + to_string(refTo) + "]");
         if (debug_y) {logg.debug("changed stop execution: " + to_string(stopExecution) + "->9");};
         stopExecution = 9;
     }
 
-    return result;
+    return List(move(result));
 };
 
-vector<string> Interpreter::getSlist(unordered_map<int, vector<string>> &slists, int key) {
-    if (slists.find(key) != slists.end()) {
-        return slists[key];
+List& Interpreter::getRefList(Item &item, List &thislist, List &dolist, List &forlist, List &uselist, List &withlist,
+                             vector<Slist> &slists) {
+    switch (item.getRefSlot()) {
+        case R_THIS:
+            return thislist;
+        case R_PARAMS:
+            return dolist;
+        case R_FORPARAMS:
+            return forlist;
+        case R_USEPARAMS:
+            return uselist;
+        case R_WITHPARAMS:
+            return withlist;
+        case R_ARGS:
+            return progargs;
+        default:
+            return getSlist(slists, item.getRefSentence());
+    }
+};
+
+// release all saved results (modifier forget)
+void Interpreter::releaseSlists(vector<Slist> &slists) {
+    for (int i = 0; i < (int) slists.size(); ++i) {
+        slists[i].valid = false;
+        slists[i].list.clear();
+    }
+}
+
+// release the saved results given by their sentence index
+void Interpreter::releaseSlists(vector<Slist> &slists, vector<int> &indexes) {
+    for (int i = 0; i < (int) indexes.size(); ++i) {
+        Slist &sl = slists[indexes[i]];
+        sl.valid = false;
+        sl.list.clear();
+    }
+}
+
+List& Interpreter::getSlist(vector<Slist> &slists, int key) {
+    if ((key >= 0) && (key < (int) slists.size()) && slists[key].valid) {
+        return slists[key].list;
     } else {
         logg.msg(FATAL, "could not find sentence reference at " + to_string(key));
         if (debug_y) {logg.debug("changed stop execution: " + to_string(stopExecution) + "->9");};
         stopExecution = 9;
-        return {};
+        lempty.clear();
+        return lempty;
     }
 };
 
-tuple<int, vector<string>> Interpreter::executeVerb(Item verb, int jump,
-                    vector<string> &thislist, vector<string> &dolist, vector<string> &forlist, vector<string> &uselist, vector<string> &withlist,
+tuple<int, List> Interpreter::executeVerb(Item &verb, int jump,
+                    List &thislist, List &dolist, List &forlist, List &uselist, List &withlist,
                     int stackLevel) {
-    string name = verb.getName();
-    if (debug_s) {logg.debug("executing verb " + name);};
     int offset;
-    vector<string> p;
-    vector<string> modifiers = verb.getParts();
-    string stype = "";
-    int verbmode = 0;
-    bool echoOut = false;
-
-    for (int i = 0; i < (int) modifiers.size(); ++i) {
-        if (modifiers[i] == "int") {
-            stype = "long";
-            if ((name != "plist")&& (name != "sort")&& (name != "pexpr")) {
-                logg.msg(WARN, "modifier int is ignored for verb " + name + ".");
-            }
-        } else if (modifiers[i] == "float") {
-            stype = "float";
-            if ((name != "plist")&& (name != "pexpr")) {
-                logg.msg(WARN, "modifier float is ignored for verb " + name + ".");
-            }
-        } else if ((modifiers[i] == "echoIn") || (modifiers[i] == "echo"))  {
-            doOut(dolist, true);
-            if (logOutput) {logg.plain(join(dolist, " "));}
-        } else if (modifiers[i] == "perRow") {
-            verbmode = 1;
-        } else if (modifiers[i] == "combine") {
-            verbmode = 2;
-        }
-
-        if ((modifiers[i] == "echoOut") || (modifiers[i] == "echo"))  {
-            echoOut = true;
-        }
-    }
+    List p;
+    // modifiers were already evaluated when creating the item
+    string stype = verb.getStype();
+    int verbmode = verb.getVerbMode();
+    beginVerb(verb, dolist);
 
     if (verbmode == 1) {
-         tie(offset, p) = executePerRowSentence3(name, verb.isStandardVerb(),jump, stype, thislist, dolist, forlist, uselist, withlist, stackLevel);
+         tie(offset, p) = executePerRowSentence3(verb, jump, stype, thislist, dolist, forlist, uselist, withlist, stackLevel);
     } else if (verbmode == 2) {
-         tie(offset, p) = executeCombineSentence(name, verb.isStandardVerb(),jump, stype, thislist, dolist, forlist, uselist, withlist, stackLevel);
+         tie(offset, p) = executeCombineSentence(verb, jump, stype, thislist, dolist, forlist, uselist, withlist, stackLevel);
+    } else if (verbmode == 3) {
+         tie(offset, p) = executeParallelSentence(verb, jump, thislist, dolist, forlist, uselist, withlist, stackLevel);
     } else {
-        tie(offset, p) = executePlainVerb(name, verb.isStandardVerb(), jump, stype, thislist, dolist, forlist, uselist, withlist, stackLevel);
+        tie(offset, p) = executePlainVerb(verb, jump, stype, thislist, dolist, forlist, uselist, withlist, stackLevel);
     }
 
-    //vector<string> w;
+    endVerb(verb, p);
+    return make_tuple(offset, p);
+};
+
+// warnings and output before the execution of a verb
+void Interpreter::beginVerb(Item &verb, List &dolist) {
+    Verbs vid = verb.getVerbId();
+    if (debug_s) {logg.debug("executing verb " + verb.getName());};
 
-    if (echoOut)  {
-        doOut(p, true);
-        if (logOutput) {logg.plain(join(p, " "));}
+    if (verb.hasModInt() && (vid != V_PLIST) && (vid != V_SORT) && (vid != V_PEXPR)) {
+        logg.msg(WARN, "modifier int is ignored for verb " + verb.getName() + ".");
     }
+    if (verb.hasModFloat() && (vid != V_PLIST) && (vid != V_PEXPR)) {
+        logg.msg(WARN, "modifier float is ignored for verb " + verb.getName() + ".");
+    }
+    if (verb.hasEchoIn()) {
+        doOut(dolist.vec(), true);
+        if (logOutput) {logg.plain(join(dolist.vec(), " "));}
+    }
+}
 
-    return make_tuple(offset, p);
-};
+// output after the execution of a verb
+void Interpreter::endVerb(Item &verb, List &p) {
+    if (verb.hasEchoOut())  {
+        doOut(p.vec(), true);
+        if (logOutput) {logg.plain(join(p.vec(), " "));}
+    }
+}
 
-tuple<int, vector<string>> Interpreter::executePlainVerb(string name, bool isStandardVerb, int jump, string stype,
-                    vector<string> &thislist, vector<string> &dolist, vector<string> &forlist, vector<string> &uselist, vector<string> &withlist,
+tuple<int, List> Interpreter::executePlainVerb(Item &verb, int jump, string stype,
+                    List &thislist, List &dolist, List &forlist, List &uselist, List &withlist,
                     int stackLevel) {
-    vector<string> p;
-    p.clear();
+    List p;
     int offset = jump;
     int newse = stopExecution;
+    Verbs vid = verb.getVerbId();
+    bool isStandardVerb = verb.isStandardVerb();
 
     try {
         if (isStandardVerb) {
-            tie(offset, p) = executeStandardVerb(name, stype, dolist, forlist, offset);
-        } else if (name == "nop") {
-            p = thislist;
-        } else if (name == "stop") {
-            offset = -1000;
-            newse = 1;
-            if (dolist.size() > 0) {
-                if (dolist[0] == "program") {
-                    newse = 9;
-                } else if (dolist[0] == "paragraph") {
-                    newse = 3;
-                }
-            }
-            if (debug_y) {logg.debug("changed stop execution: " + to_string(stopExecution) + "->" + to_string(newse));};
-            stopExecution = newse;
-            p = thislist;
-        } else if (name == "between") {
-            int len = dolist.size();
-            int flen = forlist.size();
-            if (flen==0) {
-                p = dolist;
-            } else if (len>0) {
-                int dist = 1;
-                int distcount = 0;
-                if (uselist.size()>0) {
-                    dist = stoi(uselist[0]);
+            tie(offset, p) = executeStandardVerb(vid, stype, dolist, forlist, offset, verb.getProgram());
+        } else {
+          switch (vid) {
+            case V_NOP:
+                p = thislist;
+                break;
+            case V_STOP:
+                offset = -1000;
+                newse = 1;
+                if (dolist.size() > 0) {
+                    if (dolist[0] == "program") {
+                        newse = 9;
+                    } else if (dolist[0] == "paragraph") {
+                        newse = 3;
+                    }
                 }
-                for (int i = 0; i < len - 1; ++i) {
-                    p.push_back(dolist[i]);
-                    distcount++;
-                    if (dist == distcount) {
-                        for (int j = 0; j < flen; ++j) {
-                            p.push_back(forlist[j]);
+                if (debug_y) {logg.debug("changed stop execution: " + to_string(stopExecution) + "->" + to_string(newse));};
+                stopExecution = newse;
+                p = thislist;
+                break;
+            case V_BETWEEN: {
+                int len = dolist.size();
+                int flen = forlist.size();
+                if (flen==0) {
+                    p = dolist;
+                } else if (len>0) {
+                    vector<string> b;
+                    int dist = 1;
+                    int distcount = 0;
+                    if (uselist.size()>0) {
+                        dist = stoi(uselist[0]);
+                    }
+                    for (int i = 0; i < len - 1; ++i) {
+                        b.push_back(dolist[i]);
+                        distcount++;
+                        if (dist == distcount) {
+                            for (int j = 0; j < flen; ++j) {
+                                b.push_back(forlist[j]);
+                            }
+                            distcount=0;
                         }
-                        distcount=0;
                     }
+                    b.push_back(dolist[len-1]);
+                    p = List(move(b));
                 }
-                p.push_back(dolist[len-1]);
-            }
-        } else if (name == "plist") {
-            if (forlist.size() == 0) {
-               logg.msg(WARN, "initial forlist is empty for verb plist.");
-            }
-            if (stype == "long") {
-                p = bulkExecLong(MULTI, dolist, forlist, uselist, withlist);
-            } else if (stype == "float") {
-                p = bulkExecFloat(MULTI, dolist, forlist, uselist, withlist);
-            }else {
-                p = bulkExecString(MULTI, dolist, forlist, uselist, withlist);
+                break;
             }
-        } else {
-            int index = names[name];
-            p = execParagraph(index, thislist, dolist, forlist, uselist, withlist, stackLevel + 1);
-            if (debug_c) {logg.debug("RV=" + join(p, " "));};
+            case V_PLIST:
+                if (forlist.size() == 0) {
+                   logg.msg(WARN, "initial forlist is empty for verb plist.");
+                }
+                if (stype == "long") {
+                    p = bulkExecLong(MULTI, dolist, forlist, uselist, withlist, verb.getProgram());
+                } else if (stype == "float") {
+                    p = List(bulkExecFloat(MULTI, dolist, forlist, uselist, withlist, verb.getProgram()));
+                }else {
+                    p = List(bulkExecString(MULTI, dolist, forlist, uselist, withlist, verb.getProgram()));
+                }
+                break;
+            default:
+                p = execParagraph(verb.getParaIndex(), thislist, dolist, forlist, uselist, withlist, stackLevel + 1, verb.hasMemo());
+                if (debug_c) {logg.debug("RV=" + join(p.vec(), " "));};
+          }
         }
     } catch(exception &e) {
-      logg.msg(FATAL, cstos(e.what()) + ": error when executing " + name + " for " + join(dolist, " "));
+      logg.msg(FATAL, cstos(e.what()) + ": error when executing " + verb.getName() + " for " + join(dolist.vec(), " "));
       if (debug_y) {logg.debug("changed stop execution: " + to_string(stopExecution) + "->9");};
       stopExecution = 9;
     }
@@ -483,18 +976,18 @@ tuple<int, vector<string>> Interpreter::executePlainVerb(string name, bool isSta
     // warn for std, but not returnValue
    if (isStandardVerb && (p.size() == 0)) {
        // nowarnall for returnValue, include
-      if ((name != "returnValue") && (name != "include")) {
-        logg.msg(WARNALL, "the output of standard verb " + name + " is empty.");
-        logg.msg(WARNALL, "input dolist was " + join(dolist, " "));
-        logg.msg(WARNALL, "input forlist was " + join(forlist, " "));
+      if ((vid != V_RETURNVALUE) && (vid != V_INCLUDE)) {
+        logg.msg(WARNALL, "the output of standard verb " + verb.getName() + " is empty.");
+        logg.msg(WARNALL, "input dolist was " + join(dolist.vec(), " "));
+        logg.msg(WARNALL, "input forlist was " + join(forlist.vec(), " "));
       }
    }
 
    return make_tuple(offset, p);
 }
 
-tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string stype,
-                vector<string> &dolist, vector<string> &forlist, int offset) {
+tuple<int, List> Interpreter::executeStandardVerb(Verbs verb, string stype,
+                List &dolist, List &forlist, int offset, Program *program) {
     int len = dolist.size();
     int flen = forlist.size();
     int ihelp = 0;
@@ -503,12 +996,13 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
     vector<string> p;
     string progress = "begin";
 
-     if (name == "del") {
+    switch (verb) {
+    case V_DEL: {
         try {
             if (flen < 100) {
                 for (int i = 0; i < len; ++i) {
                     help = to_string(i+1);
-                    if(!contains(help, forlist)) {
+                    if(!contains(help, forlist.vec())) {
                         p.push_back(dolist[i]);
                     }
                 }
@@ -532,12 +1026,14 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
                 f.clear();
             }
         } catch (exception& e) {
-           logg.msg(FATAL, cstos(e.what()) + ": error when executing del for " + join(dolist, " "));
+           logg.msg(FATAL, cstos(e.what()) + ": error when executing del for " + join(dolist.vec(), " "));
            if (debug_y) {logg.debug("changed stop execution: " + to_string(stopExecution) + "->9");};
            stopExecution = 9;
         }
+        break;
+    }
     // --------------------------------------
-    } else if (name == "expand") {
+    case V_EXPAND: {
         //split every char (except space, tab)
         for (int i = 0; i < len; ++i) {
             string x = dolist[i];
@@ -546,25 +1042,21 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
                 if ((c != ' ') && (c != '\t')) {p.push_back(ctos(x[j]));};
             }
         }
+        break;
+    }
     // --------------------------------------
-    } else if (name == "cond") {
+    case V_COND: {
         if (len == 0) {
            if (debug_y) {logg.debug("changed stop execution (in cond): " + to_string(stopExecution) + "->9");};
            logg.msg(FATAL, "condition is empty");
            stopExecution = 9;
         } else {
            if (dolist[0] == "int") {
-                vector<string> dl;
-                addToVector(dl, dolist);
-                dl.erase(dl.begin());
-                p = bulkExecLong(SINGLE, dl, vempty, vempty, vempty);
+                p = bulkExecLong(SINGLE, dolist.slice(1, len), lempty, lempty, lempty, program).vec();
            } else if (dolist[0] == "float") {
-                vector<string> dl;
-                addToVector(dl, dolist);
-                dl.erase(dl.begin());
-                p = bulkExecFloat(SINGLE, dl, vempty, vempty, vempty);
+                p = bulkExecFloat(SINGLE, dolist.slice(1, len), lempty, lempty, lempty, program);
            } else {
-                p = bulkExecString(SINGLE, dolist, vempty, vempty, vempty);
+                p = bulkExecString(SINGLE, dolist, lempty, lempty, lempty, program);
            }
            // condition fulfilled => goto next
            if (p.size() > 0) {
@@ -572,8 +1064,10 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
                if (res > 0) {myoffset = 1;}
            }
        }
+        break;
+    }
     // --------------------------------------
-     } else if (name == "file") {
+    case V_FILE: {
         int i = 0;
         int j = 0;
         if ((len>0) && (flen>0)) {
@@ -587,13 +1081,15 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
                 }
             }
         }
-         // --------------------------------------
-     } else if (name == "find") {
+        break;
+    }
+    // --------------------------------------
+    case V_FIND: {
         try {
             if (flen < 100) {
                 for (int i = 0; i < len; ++i) {
                     help = dolist[i];
-                    if(contains(help, forlist)) {
+                    if(contains(help, forlist.vec())) {
                         p.push_back(to_string(i+1));
                     }
                 }
@@ -616,15 +1112,19 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
                f.clear();
             }
         } catch (exception& e) {
-           logg.msg(FATAL, cstos(e.what()) + ": error when executing find for " + join(dolist, " "));
+           logg.msg(FATAL, cstos(e.what()) + ": error when executing find for " + join(dolist.vec(), " "));
            if (debug_y) {logg.debug("changed stop execution (find): " + to_string(stopExecution) + "->9");};
            stopExecution = 9;
         }
-        // --------------------------------------
-     } else if (name == "freq") {
-         p=freq(dolist, forlist);
+        break;
+    }
+    // --------------------------------------
+    case V_FREQ: {
+         p=freq(dolist, forlist.vec());
+        break;
+    }
     // --------------------------------------
-    } else if (name == "get") {
+    case V_GET: {
         try {
             for (int i = 0; i < flen; ++i) {
                 ihelp = stoi(forlist[i]) - 1;
@@ -633,24 +1133,32 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
                 }
             }
         } catch (exception& e) {
-           logg.msg(FATAL, cstos(e.what()) + ": error when executing get for " + join(dolist, " "));
+           logg.msg(FATAL, cstos(e.what()) + ": error when executing get for " + join(dolist.vec(), " "));
            if (debug_y) {logg.debug("changed stop execution (get): " + to_string(stopExecution) + "->9");};
            stopExecution = 9;
         }
+        break;
+    }
     // --------------------------------------
-    } else if (name == "id") {
-        p = dolist;
+    case V_ID: {
+        return make_tuple(myoffset, dolist);
+        break;
+    }
     // --------------------------------------
-    } else if (name == "input") {
-       string x = join(dolist, " ") + " ";
+    case V_INPUT: {
+       string x = join(dolist.vec(), " ") + " ";
        cout << x;
        cin >> help;
        p.push_back(help);
+        break;
+    }
     // --------------------------------------
-    } else if (name == "include") {
+    case V_INCLUDE: {
         // do nothing, is already handled
+        break;
+    }
     // --------------------------------------
-    } else if (name == "ins") {
+    case V_INS: {
         int ix = stoi(forlist[0]);
         for (int i = 0; i < len; ++i) {
             if (ix == i) {
@@ -665,19 +1173,23 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
                 p.push_back(forlist[j]);
              }
         }
+        break;
+    }
     // --------------------------------------
-    } else if (name == "join") {
+    case V_JOIN: {
         if (len > 0) {
             if (flen > 0) {
                 help = forlist[0];
 				if (help == "#space") {help = " ";}
-				p.push_back(join(dolist,help));
+				p.push_back(join(dolist.vec(),help));
             } else {
-				p.push_back(join(dolist, ""));
+				p.push_back(join(dolist.vec(), ""));
 		  	}
         }
+        break;
+    }
     // --------------------------------------
-    } else if (name == "mask") {
+    case V_MASK: {
         if ((len>0)&&(flen>0)) {
             int ihelp = -1;
             for (int i = 0; i < len; ++i) {
@@ -690,69 +1202,85 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
                 }
             }
         } else if (len>0) {
-            p = dolist;
+            return make_tuple(myoffset, dolist);
         }
+        break;
+    }
     // --------------------------------------
-    } else if (name == "minus") {
+    case V_MINUS: {
         if ((len>0)&&(flen>0)) {
-            p = vminus(forlist,dolist);
+            p = vminus(forlist.vec(),dolist.vec());
         } else if (flen > 0) {
-            p = forlist;
+            return make_tuple(myoffset, forlist);
         }
+        break;
+    }
     // --------------------------------------
-     }  else if (name == "output") {
-        doOut(dolist, true);
-        p = dolist;
-        if (logOutput) {logg.plain(join(dolist, " "));}
+    case V_OUTPUT: {
+        doOut(dolist.vec(), true);
+        if (logOutput) {logg.plain(join(dolist.vec(), " "));}
+        return make_tuple(myoffset, dolist);
+        break;
+    }
     // --------------------------------------
-     }  else if (name == "pexpr") {
+    case V_PEXPR: {
         if (stype == "long") {
-             p = bulkExecLong(SINGLE, dolist, vempty, vempty, vempty);
+             return make_tuple(myoffset, bulkExecLong(SINGLE, dolist, lempty, lempty, lempty, program));
         }else if (stype == "float") {
-             p = bulkExecFloat(SINGLE, dolist, vempty, vempty, vempty);
+             p = bulkExecFloat(SINGLE, dolist, lempty, lempty, lempty, program);
         } else {
-             p = bulkExecString(SINGLE, dolist, vempty, vempty, vempty);
+             p = bulkExecString(SINGLE, dolist, lempty, lempty, lempty, program);
         }
+        break;
+    }
     // --------------------------------------
-    } else if (name == "print") {
-        doPrint(dolist, false);
-        p = dolist;
-        if (logOutput) {logg.plain(join(dolist, " "));}
+    case V_PRINT: {
+        doPrint(dolist.vec(), false);
+        if (logOutput) {logg.plain(join(dolist.vec(), " "));}
+        return make_tuple(myoffset, dolist);
+        break;
+    }
     // --------------------------------------
-       } else if (name == "range") {
+    case V_RANGE: {
         try {
+          // all elements are numbers, so their values are passed on
+          vector<long long int> values;
           if (len >= 2) {
-            vector<bool> up = getUp(dolist);
-            vector<string> first = getRange(dolist[0], dolist[1], "0", up[0]);
+            vector<bool> up = getUp(dolist.vec());
+            vector<int> first = getRange(dolist[0], dolist[1], "0", up[0]);
             for (int i=0;i<(int)first.size();i++) {
                 if (len >= 4) {
-                   vector<string> second = getRange(dolist[2], dolist[3], first[i], up[1]);
+                   vector<int> second = getRange(dolist[2], dolist[3], to_string(first[i]), up[1]);
                    for (int j=0;j<(int) second.size();j++) {
                        if (len >= 6) {
-                            vector<string> third = getRange(dolist[4], dolist[5], second[j], up[2]);
+                            vector<int> third = getRange(dolist[4], dolist[5], to_string(second[j]), up[2]);
                             for (int k=0;k<(int)third.size();k++) {
-                                p.push_back(first[i]);
-                                p.push_back(second[j]);
-                                p.push_back(third[k]);
+                                values.push_back(first[i]);
+                                values.push_back(second[j]);
+                                values.push_back(third[k]);
                             }
                        } else {
-                            p.push_back(first[i]);
-                            p.push_back(second[j]);
+                            values.push_back(first[i]);
+                            values.push_back(second[j]);
                        }
                    }
                 } else {
-                   p.push_back(first[i]);
+                   values.push_back(first[i]);
                 }
             }
           }
+          p.reserve(values.size());
+          for (long long int v : values) {p.push_back(to_string(v));}
+          return make_tuple(myoffset, List(move(p), move(values)));
         } catch (exception& e) {
-            logg.msg(FATAL, cstos(e.what()) + ": could not execute range on " + join(dolist, " "));
+            logg.msg(FATAL, cstos(e.what()) + ": could not execute range on " + join(dolist.vec(), " "));
             if (debug_y) {logg.debug("changed stop execution (range): " + to_string(stopExecution) + "->9");};
             stopExecution = 9;
         }
+        break;
+    }
     // --------------------------------------
-
-    } else if (name == "readLines") {
+    case V_READLINES: {
         bool keepEmpty = false;
         bool keepEol = false;
         bool keepEof = false;
@@ -785,36 +1313,42 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
             }
         }
 
+        break;
+    }
     // --------------------------------------
-    } else if (name == "reverse") {
+    case V_REVERSE: {
        for (int i = len-1; i >= 0; --i) {
             p.push_back(dolist[i]);
        }
+        break;
+    }
     // --------------------------------------
-    } else if (name == "returnValue") {
-        for (int i = 0; i < len; ++i) {
-            p.push_back(dolist[i]);
-        }
+    case V_RETURNVALUE: {
+        return make_tuple(myoffset, dolist);
+        break;
+    }
     // --------------------------------------
-    } else if (name == "set") {
+    case V_SET: {
        try {
            for (int i = 0; i < flen; i+=2) {
                int ix = stoi(forlist[i]);
                if ((i+1) < flen) {
                     help = forlist[i+1];
-                    if ((ix>0)&& (ix<=len)){dolist[ix - 1] = help;}
+                    if ((ix>0)&& (ix<=len)){dolist.edit()[ix - 1] = help;}
                } else {
                     logg.msg(WARN, "missing value for set was ignored");
                }
            }
-           addToVector(p, dolist);
+           return make_tuple(myoffset, dolist);
        } catch(exception& e) {
-           logg.msg(FATAL, cstos(e.what()) + ": error when executing set with forlist " + join(forlist, " "));
+           logg.msg(FATAL, cstos(e.what()) + ": error when executing set with forlist " + join(forlist.vec(), " "));
            if (debug_y) {logg.debug("changed stop execution (set): " + to_string(stopExecution) + "->9");};
            stopExecution = 9;
        }
+        break;
+    }
     // --------------------------------------
-    } else if (name == "sort") {
+    case V_SORT: {
         bool isDesc = false;
         bool hasRows = false;
         int index = 0;
@@ -834,11 +1368,11 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
             if ((stype == "long") || (stype == "int")) {
                 sortRowsLong(index, rowlen, isDesc, dolist, p);
             } else {
-                sortRowsString(index, rowlen, isDesc, dolist, p);
+                sortRowsString(index, rowlen, isDesc, dolist.vec(), p);
             }
         } else if (stype == "") {
             try {
-                p = dolist;
+                p.assign(dolist.begin(), dolist.end());
                 if (isDesc) {
                     sort (p.begin(), p.end(), greater <> ());
                 } else {
@@ -852,7 +1386,7 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
     // --------------------------------------
         } else if (stype == "int") {
             try {
-                p = dolist;
+                p.assign(dolist.begin(), dolist.end());
                 if (isDesc) {
                     sort (p.begin(), p.end(), gtstoi <string> ());
                 } else {
@@ -866,20 +1400,35 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
     // --------------------------------------
         } else if (stype == "long") {
             try {
-                p = dolist;
+                // every element is parsed once, the sorted values are passed on with the elements
+                vector<long long int> values(len);
+                vector<int> order(len);
+                for (int i = 0; i < len; ++i) {
+                    values[i] = dolist.getLong(i);
+                    order[i] = i;
+                }
                 if (isDesc) {
-                    sort (p.begin(), p.end(), gtstoll <string> ());
+                    sort (order.begin(), order.end(), [&values](int x, int y) {return values[x] > values[y];});
                 } else {
-                    sort (p.begin(), p.end(), ltstoll <string> ());
+                    sort (order.begin(), order.end(), [&values](int x, int y) {return values[x] < values[y];});
+                }
+                vector<long long int> sorted(len);
+                p.resize(len);
+                for (int i = 0; i < len; ++i) {
+                    p[i] = dolist[order[i]];
+                    sorted[i] = values[order[i]];
                 }
+                return make_tuple(myoffset, List(move(p), move(sorted)));
             } catch (exception& e) {
                logg.msg(FATAL, cstos(e.what()) + ": error when executing sort-long");
                if (debug_y) {logg.debug("changed stop execution (sort): " + to_string(stopExecution) + "->9");};
                stopExecution = 9;
              }
         }
-        // --------------------------------------
-    } else if (name == "split") {
+        break;
+    }
+    // --------------------------------------
+    case V_SPLIT: {
         if(len>0) {
            if(flen>0) {
                 help = forlist[0];
@@ -901,11 +1450,15 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
                 }
            }
         }
+        break;
+    }
     // --------------------------------------
-     } else if (name == "time") {
-         p = timeverb(dolist);
+    case V_TIME: {
+         p = timeverb(dolist.vec());
+        break;
+    }
     // --------------------------------------
-    } else if (name == "unique") {
+    case V_UNIQUE: {
         try {
             progress = "init";
            unordered_map<string, int> f;
@@ -928,167 +1481,98 @@ tuple<int, vector<string>> Interpreter::executeStandardVerb(string name, string
            if (debug_y) {logg.debug("changed stop execution (unique): " + to_string(stopExecution) + "->9");};
            stopExecution = 9;
         }
-     // --------------------------------------
-    } else if (name == "writeLines") {
+        break;
+    }
+    // --------------------------------------
+    case V_WRITELINES: {
         string x = forlist[0];
         if (!isPath(x)) {x=currDir+x;}
-        bool retcode = writeFile(x, dolist);
+        bool retcode = writeFile(x, dolist.vec());
         if (retcode) {
             p.push_back("1");
         } else {
             p.push_back("0");
         }
+        break;
+    }
+    default:
+        break;
     }
 
-    return make_tuple(myoffset, p);
+    return make_tuple(myoffset, List(move(p)));
 }
 
-tuple<int, vector<string>> Interpreter::executePerRowSentence3(string name, bool isStandardVerb, int jump, string stype,
-                       vector<string> &thislist, vector<string> &dolist, vector<string> &forlist, vector<string> &uselist, vector<string> &withlist, int stackLevel) {
+tuple<int, List> Interpreter::executePerRowSentence3(Item &verb, int jump, string stype,
+                       List &thislist, List &dolist, List &forlist, List &uselist, List &withlist, int stackLevel) {
    		if (debug_t) {logg.debugtime("@init");};
+        string name = verb.getName();
 
    		if (debug_b) {logg.msg(DEBUG, "starting perRow for Verb " + name);};
         int offset = 1;
-        vector<string> p;
+        List p;
 		vector<string> result;
         int uselen = uselist.size();
         if (uselen == 0) {
                logg.msg(WARN, "uselist is empty for modifier perRow.");
             }
-        Rowdefs rowdefs = getPerRowDefs(dolist);
-        vector<Rowitem> rowitems = getPerRowItems(rowdefs.offset, dolist);
-        int off = 0;
-        int ix = 0;
+        // a pattern of plain values is parsed by the fourth parse
+        Rowplan *plan = verb.getRowplan();
+        unique_ptr<Rowplan> parsed;
+        if (plan == nullptr) {
+            parsed = make_unique<Rowplan>(dolist.vec());
+            plan = parsed.get();
+        }
+        for (const string &text : plan->errors) {
+            logg.msg(ERROR, " row length is not an integer: " + text + " - assume 1.");
+        }
+        if (!plan->foundBar) {
+            logg.msg(ERROR, "no bar separator '|' found in perRow pattern");
+            if (debug_y) {logg.debug("changed stop execution (perRow): " + to_string(stopExecution) + "->9");};
+            stopExecution = 9;
+        }
+        const Rowdefs &rowdefs = plan->rowdefs;
+        // pexpr-int/float with a compiled pattern computes the rows without building them
+        bool fused = (plan->program != nullptr) && !debug_t && !debug_b;
+        Program prog;
+        if (fused) {prog = *plan->program;}
+        Chunk ch;
 
         if (rowdefs.inits.size() > 0) {
             addToVector(result, rowdefs.inits);
         }
- 		vector<string> bhelp;
-		string shelp = "";
-		string thelp = "";
-		string entry = "";
-		bool isValid = true;
-		Rowitem ri = Rowitem("");
-		for (int i=0; i<uselen; i+=rowdefs.rowlength) {
-			isValid = true;
-			off = 0;
-			bhelp.clear();
+        // the rows of a pure paragraph are independent if they don't read the result
+        bool parallel = !fused && !plan->readsResult && (rowdefs.rowlength > 0)
+                        && isParallel(verb, (uselen + rowdefs.rowlength - 1) / rowdefs.rowlength);
+        if (parallel) {
+            int rowlength = rowdefs.rowlength;
+            executeRowsParallel((uselen + rowlength - 1) / rowlength, thislist, forlist, uselist, withlist, true, name, result,
+                [&](Interpreter &helper, int r, List *pa, List &rp) {
+                    vector<string> row;
+                    if (!helper.buildRow(*plan, r * rowlength, name, uselist, withlist, helper.vempty, row)) {return false;}
+                    List prow(move(row));
+                    rp = helper.execParagraph(verb.getParaIndex(), pa[0], prow, pa[1], pa[2], pa[3], 0, verb.hasMemo());
+                    if (debug_c) {helper.logg.debug("RV=" + join(rp.vec(), " "));};
+                    return true;
+                });
+        }
+		vector<string> bhelp;
+		for (int i=0; (i<uselen) && !parallel; i+=rowdefs.rowlength) {
+			if (fused && execRowplan(*plan, prog, stype == "long", i, uselist, withlist, result, ch)) {continue;}
 			p.clear();
-			int emptyEntries = 0;
-			entry = "";
-            for (int j=0; j<(int)rowitems.size(); ++j) {
-                ri = rowitems[j];
-                switch (ri.typ) {
-                   case 0:
-                        entry = ri.plain;
-                        break;
-                   case 1:
-                        if (off>=rowdefs.rowlength) {off=0;}
-                        if (i+off<uselen){
-                           entry = uselist[i+off];
-                           ++off;
-                        } else if (rowdefs.hasDefuse) {
-                           entry = rowdefs.defuse;
-                           ++off;
-                        } else {
-                           bhelp.clear();
-                           entry = "";
-                           if (debug_x) {logg.debug("#:i+off>=uselen for i=" + to_string(i));};
-                           isValid = false;
-                        }
-                        break;
-                   case 2:
-                      ix = ri.index-1;
-                      if ((i+ix >= 0) && (i + ix <uselen)) {
-                         entry = uselist[i+ix];
-                      } else if (rowdefs.hasDefuse) {
-                         entry = rowdefs.defuse;
-                      } else {
-                         bhelp.clear();
-                         entry = "";
-                         if (debug_x) {logg.debug("#<n>:i+ix>=uselen or <0 for i=" + to_string(i));};
-                         isValid = false;
-                      }
-                      break;
-                   case 3:
-                        ix = ri.index-1;
-                      if ((i+ix >= 0) && (i + ix <(int) withlist.size())) {
-                         entry = withlist[i+ix];
-                      } else if (rowdefs.hasDefwith) {
-                         entry = rowdefs.defwith;
-                      } else {
-                         entry = "";
-                         bhelp.clear();
-                         if (debug_x) {logg.debug("#<n>:i+ix>=withlen or <0 for i=" + to_string(i));};
-                         isValid = false;
-                      }
-                      break;
-                   case 4:
-                        ix = ri.index-1;
-                        if ((i+ix >= 0) && (i + ix <(int)result.size())) {
-                           entry = result[i+ix];
-                        } else if (rowdefs.hasDefres) {
-                            entry = rowdefs.defres;
-                        } else {
-                            bhelp.clear();
-                            entry = "";
-                            if (debug_y) {logg.debug("#<n>:i+ix>=reslen or <0 for i=" + to_string(i));};
-                            isValid = false;
-                        }
-                        break;
-                   case 5:
-                        entry = to_string(i+1);
-                        break;
-                   case 6:
-                        entry = "#all";
-                        break;
-                   case 7:
-                        if (result.size() > 0) {
-                            entry = result.back();
-                        } else if (rowdefs.hasDefres) {
-                            entry = rowdefs.defres;
-                        } else {
-                            bhelp.clear();
-                            entry = "";
-                            if (debug_y) {logg.debug("can't use #rend on empty result list");};
-                            isValid = false;
-                        }
-                        break;
-                }
-                if (!isValid) {
-                    logg.msg(WARNALL, "no valid result for " + name + " in perRow.");
-                    break;
-                }
-
-                if (entry == "#all") {
-                   for (int j=i; j<i+rowdefs.rowlength; j++) {
-                        bhelp.push_back(uselist[j]);
-                   }
-                } else if (entry.size() > 0) {
-                    bhelp.push_back(entry);
-                } else {
-                    ++emptyEntries;
-                }
-             }
-
-            if (emptyEntries > 0) {
-                logg.msg(WARNALL, to_string(emptyEntries) + " empty entries found. Possibly incomplete pattern for " + name + ": " + join(bhelp, ",") +  "was ignored.");
-                isValid = false;
-            }
-			if (isValid) {
-                if (isStandardVerb) {
-                    tie(offset, p) = executeStandardVerb(name, stype, bhelp, forlist, offset);
-                } else if (names.find(name) != names.end()) {
-                    int index = names[name];
-                    p = execParagraph(index, thislist, bhelp, forlist, uselist, withlist, 0);
-                    if (debug_c) {logg.debug("RV=" + join(p, " "));};
+			if (buildRow(*plan, i, name, uselist, withlist, result, bhelp)) {
+                List row(move(bhelp));
+                if (verb.isStandardVerb()) {
+                    tie(offset, p) = executeStandardVerb(verb.getVerbId(), stype, row, forlist, offset, nullptr);
+                } else if (verb.getParaIndex() >= 0) {
+                    p = execParagraph(verb.getParaIndex(), thislist, row, forlist, uselist, withlist, 0, verb.hasMemo());
+                    if (debug_c) {logg.debug("RV=" + join(p.vec(), " "));};
                 } else {
                     logg.msg(FATAL, "verb not allowed for perRow or unknown: " + name + ".");
                     if (debug_y) {logg.debug("changed stop execution (perRow): " + to_string(stopExecution) + "->9");};
                     stopExecution = 9;
                 }
                 if (p.size() > 0) {
-                    addToVector(result, p);
+                    result.insert(result.end(), p.begin(), p.end());
                 } else {
                     logg.msg(WARNALL, "empty result for " + name + " in perRow - ignored.");
                 }
@@ -1100,22 +1584,317 @@ tuple<int, vector<string>> Interpreter::executePerRowSentence3(string name, bool
     if (debug_b) {logg.msg(DEBUG, "finished perRow for Verb " + name);};
     stopExecution =newStopExecution(stopExecution, LOOP);
     if (debug_t) {logg.debugtime("time for " + name + "-perRow: ");};
-    return make_tuple(offset, result);
+    return make_tuple(offset, List(move(result)));
   }
 
-vector<string> Interpreter::getRange(string sfrom, string sto, string sprev, bool  up) {
-     vector<string> result;
+// perRow and combine may execute their rows in parallel if the verb is a pure paragraph (and the rows don't
+// depend on each other)
+bool Interpreter::isParallel(Item &verb, long long int rows) {
+    int index = verb.isStandardVerb() ? -1 : verb.getParaIndex();
+    return (index >= 0) && paragraphs[index].isPure() && (rows > 1) && (pool->getThreads() > 1) && (maxDepth == 0)
+           && (stopExecution == 0);
+}
+
+// independent rows of perRow or combine: the workers of the pool take the rows one by one and execute them
+// on interpreters of their own (execRow returns false for a row which is not valid).
+// The results and the messages of the rows are merged in row order, up to the first row which stopped.
+void Interpreter::executeRowsParallel(int rows, List &thislist, List &forlist, List &uselist, List &withlist,
+                                      bool warnEmpty, const string &name, vector<string> &result,
+                                      const function<bool(Interpreter &, int, List *, List &)> &execRow) {
+    int workers = pool->getThreads();
+    while ((int) helpers.size() < workers) {
+        helpers.push_back(unique_ptr<Interpreter>(new Interpreter(this)));
+    }
+    vector<List> results(rows);
+    vector<vector<pair<Level, string>>> messages(rows);
+    vector<int> stops(rows, 0);
+    vector<char> valid(rows, 0);
+    // every worker passes its own copies of the lists, since reading a slice replaces it by a copy
+    vector<List> params;
+    for (int c = 0; c < workers; ++c) {
+        params.insert(params.end(), {thislist, forlist, uselist, withlist});
+    }
+    atomic<int> next(0);
+    atomic<int> stopRow(rows);
+    pool->run(workers, [&](int c) {
+        Interpreter &helper = *helpers[c];
+        helper.baseDepth = baseDepth + depth;
+        // the thread may be inside a row or a call of another job
+        vector<pair<Level, string>> *capture = Log::capture;
+        bool concurrent = List::concurrent;
+        List::concurrent = true;
+        for (int r = next++; (r < rows) && (r <= stopRow); r = next++) {
+            Log::capture = &messages[r];
+            helper.stopExecution = 0;
+            if (execRow(helper, r, &params[4 * c], results[r])) {
+                valid[r] = 1;
+                stops[r] = helper.stopExecution;
+                // the rows after a stopped row are not needed
+                int s = stopRow;
+                while ((stops[r] > 0) && (r < s) && !stopRow.compare_exchange_weak(s, r)) {}
+            }
+        }
+        Log::capture = capture;
+        List::concurrent = concurrent;
+    });
+
+    for (int r = 0; r < rows; ++r) {
+        for (const pair<Level, string> &m : messages[r]) {logg.msg(m.first, m.second);}
+        if (!valid[r]) {continue;}
+        if (results[r].size() > 0) {
+            result.insert(result.end(), results[r].begin(), results[r].end());
+        } else if (warnEmpty) {
+            logg.msg(WARNALL, "empty result for " + name + " in perRow - ignored.");
+        }
+        if (stops[r] > 0) {
+            stopExecution = stops[r];
+            break;
+        }
+    }
+}
+
+// the parameters of the row at i of perRow, false if the row is not valid (the warnings are logged)
+bool Interpreter::buildRow(const Rowplan &plan, int i, const string &name, const List &uselist, const List &withlist,
+                           const vector<string> &result, vector<string> &row) {
+    static const string ALL = "#all";
+    static const string EMPTY = "";
+    const Rowdefs &rowdefs = plan.rowdefs;
+    const vector<Rowitem> &rowitems = plan.rowitems;
+    int uselen = uselist.size();
+    int off = 0;
+    int ix = 0;
+    string index;
+    const string *entry = &EMPTY;
+    bool isValid = true;
+    int emptyEntries = 0;
+    row.clear();
+    for (int j=0; j<(int)rowitems.size(); ++j) {
+        const Rowitem &ri = rowitems[j];
+        switch (ri.typ) {
+           case 0:
+                entry = &ri.plain;
+                break;
+           case 1:
+                if (off>=rowdefs.rowlength) {off=0;}
+                if (i+off<uselen){
+                   entry = &uselist[i+off];
+                   ++off;
+                } else if (rowdefs.hasDefuse) {
+                   entry = &rowdefs.defuse;
+                   ++off;
+                } else {
+                   row.clear();
+                   entry = &EMPTY;
+                   if (debug_x) {logg.debug("#:i+off>=uselen for i=" + to_string(i));};
+                   isValid = false;
+                }
+                break;
+           case 2:
+              ix = ri.index-1;
+              if ((i+ix >= 0) && (i + ix <uselen)) {
+                 entry = &uselist[i+ix];
+              } else if (rowdefs.hasDefuse) {
+                 entry = &rowdefs.defuse;
+              } else {
+                 row.clear();
+                 entry = &EMPTY;
+                 if (debug_x) {logg.debug("#<n>:i+ix>=uselen or <0 for i=" + to_string(i));};
+                 isValid = false;
+              }
+              break;
+           case 3:
+                ix = ri.index-1;
+              if ((i+ix >= 0) && (i + ix <(int) withlist.size())) {
+                 entry = &withlist[i+ix];
+              } else if (rowdefs.hasDefwith) {
+                 entry = &rowdefs.defwith;
+              } else {
+                 entry = &EMPTY;
+                 row.clear();
+                 if (debug_x) {logg.debug("#<n>:i+ix>=withlen or <0 for i=" + to_string(i));};
+                 isValid = false;
+              }
+              break;
+           case 4:
+                ix = ri.index-1;
+                if ((i+ix >= 0) && (i + ix <(int)result.size())) {
+                   entry = &result[i+ix];
+                } else if (rowdefs.hasDefres) {
+                    entry = &rowdefs.defres;
+                } else {
+                    row.clear();
+                    entry = &EMPTY;
+                    if (debug_y) {logg.debug("#<n>:i+ix>=reslen or <0 for i=" + to_string(i));};
+                    isValid = false;
+                }
+                break;
+           case 5:
+                index = to_string(i+1);
+                entry = &index;
+                break;
+           case 6:
+                entry = &ALL;
+                break;
+           case 7:
+                if (result.size() > 0) {
+                    entry = &result.back();
+                } else if (rowdefs.hasDefres) {
+                    entry = &rowdefs.defres;
+                } else {
+                    row.clear();
+                    entry = &EMPTY;
+                    if (debug_y) {logg.debug("can't use #rend on empty result list");};
+                    isValid = false;
+                }
+                break;
+        }
+        if (!isValid) {
+            logg.msg(WARNALL, "no valid result for " + name + " in perRow.");
+            break;
+        }
+
+        if (*entry == ALL) {
+           for (int j=i; j<i+rowdefs.rowlength; j++) {
+                row.push_back(uselist[j]);
+           }
+        } else if (entry->size() > 0) {
+            row.push_back(*entry);
+        } else {
+            ++emptyEntries;
+        }
+     }
+
+    if (emptyEntries > 0) {
+        logg.msg(WARNALL, to_string(emptyEntries) + " empty entries found. Possibly incomplete pattern for " + name + ": " + join(row, ",") +  "was ignored.");
+        isValid = false;
+    }
+    return isValid;
+}
+
+// a row of pexpr-int/float-perRow computed by the compiled pattern, false if the row has to be built as usual
+// (which then also reports the warnings and errors)
+bool Interpreter::execRowplan(const Rowplan &plan, Program &prog, bool isLong, int i, const List &uselist,
+                              const List &withlist, vector<string> &result, Chunk &ch) {
+    const Rowdefs &rowdefs = plan.rowdefs;
+    int uselen = uselist.size();
+    int off = 0;
+    int ix = 0;
+    try {
+        for (size_t j = 0; j < plan.rowitems.size(); ++j) {
+            const Rowitem &ri = plan.rowitems[j];
+            if (ri.typ == 0) {continue;}
+            const List *list = nullptr;
+            const string *text = nullptr;
+            int k = 0;
+            switch (ri.typ) {
+               case 1:
+                    if (off>=rowdefs.rowlength) {off=0;}
+                    if (i+off<uselen) {
+                        list = &uselist;
+                        k = i+off;
+                    } else if (rowdefs.hasDefuse) {
+                        text = &rowdefs.defuse;
+                    } else {
+                        return false;
+                    }
+                    ++off;
+                    break;
+               case 2:
+                    ix = ri.index-1;
+                    if ((i+ix >= 0) && (i + ix <uselen)) {
+                        list = &uselist;
+                        k = i+ix;
+                    } else if (rowdefs.hasDefuse) {
+                        text = &rowdefs.defuse;
+                    } else {
+                        return false;
+                    }
+                    break;
+               case 3:
+                    ix = ri.index-1;
+                    if ((i+ix >= 0) && (i + ix <(int) withlist.size())) {
+                        list = &withlist;
+                        k = i+ix;
+                    } else if (rowdefs.hasDefwith) {
+                        text = &rowdefs.defwith;
+                    } else {
+                        return false;
+                    }
+                    break;
+               case 4:
+                    ix = ri.index-1;
+                    if ((i+ix >= 0) && (i + ix <(int)result.size())) {
+                        text = &result[i+ix];
+                    } else if (rowdefs.hasDefres) {
+                        text = &rowdefs.defres;
+                    } else {
+                        return false;
+                    }
+                    break;
+               case 5:
+                    break;
+               case 7:
+                    if (result.size() > 0) {
+                        text = &result.back();
+                    } else if (rowdefs.hasDefres) {
+                        text = &rowdefs.defres;
+                    } else {
+                        return false;
+                    }
+                    break;
+               default:
+                    return false;
+            }
+            // the value is pushed like a plain value of the row, anything else (e.g. an opcode) builds the row
+            Instr &in = prog.instrs[plan.slots[j]];
+            if (ri.typ == 5) {
+                in.lvalue = i+1;
+                in.dvalue = i+1;
+            } else {
+                const string &s = list ? (*list)[k] : *text;
+                if (!Program::startsNumber(s, isLong)) {return false;}
+                if (isLong) {
+                    in.lvalue = list ? list->getLong(k) : stoll(s);
+                } else {
+                    in.dvalue = list ? list->getDouble(k) : stod(s);
+                }
+            }
+            in.hasLong = isLong;
+            in.hasDouble = !isLong;
+        }
+    } catch (exception &e) {
+        return false;
+    }
+
+    ch.result.clear();
+    ch.values.clear();
+    ch.events.clear();
+    ch.failed = false;
+    ch.error = false;
+    ch.sp = 0;
+    if (isLong) {
+        execRowsLong(SINGLE, prog, lempty, lempty, uselist, withlist, nullptr, 0, 0, true, ch);
+    } else {
+        execRowsFloat(SINGLE, prog, lempty, lempty, uselist, withlist, 0, 0, true, ch);
+    }
+    if (ch.failed || ch.error || (ch.events.size() > 0) || (ch.result.size() == 0)) {return false;}
+    result.insert(result.end(), make_move_iterator(ch.result.begin()), make_move_iterator(ch.result.end()));
+    return true;
+}
+
+vector<int> Interpreter::getRange(string sfrom, string sto, string sprev, bool  up) {
+     vector<int> result;
 
      int x = getRangeIndex(sfrom, sprev);
      int y = getRangeIndex(sto, sprev);
 
      if ((x<=y) && up){
         for (int j = x; j <= y; ++j) {
-            result.push_back(to_string(j));
+            result.push_back(j);
         }
      } else if ((x>y) && (!up)){
         for (int j = x; j >= y; --j) {
-             result.push_back(to_string(j));
+             result.push_back(j);
         }
     }
     return result;
@@ -1135,7 +1914,7 @@ int Interpreter::getRangeIndex(string r, string prev) {
      return result;
 }
 
-vector<bool> Interpreter::getUp(vector<string> therange) {
+vector<bool> Interpreter::getUp(const vector<string> &therange) {
     vector<bool> up;
      int x = 0;
      int y = 0;
@@ -1174,149 +1953,91 @@ int Interpreter::getDefLength(string text) {
     return result;
   }
 
-Rowdefs Interpreter::getPerRowDefs(vector<string>& v) {
-      Rowdefs rowdefs;
-      rowdefs.offset = 0;
-      rowdefs.rowlength = 1;
-      rowdefs.hasDefuse = false;
-      rowdefs.hasDefwith = false;
-      rowdefs.hasDefres = false;
-      string text;
-      string help;
-      bool foundBar = false;
-      int len = v.size();
-      int i = 0;
-      while (i<len) {
-        text = v[i];
-        if (text.substr(0, 3) == "row") {
-            help = text.substr(3);
-            if (!isInt(help)) {
-                logg.msg(ERROR, " row length is not an integer: " + text + " - assume 1.");
-            } else {
-                rowdefs.rowlength = stoi(help);
-            }
-        } else if (text.substr(0, 3) == "def") {
-            rowdefs.defuse = text.substr(3);
-            rowdefs.hasDefuse = true;
-        } else if ((text.substr(0, 4) == "rdef") && isExtended) {
-            rowdefs.defres = text.substr(4);
-            rowdefs.hasDefres = true;
-        } else if ((text.substr(0, 4) == "wdef") && isExtended) {
-            rowdefs.defwith = text.substr(4);
-            rowdefs.hasDefwith = true;
-        } else if ((text.substr(0, 4) == "init") && isExtended) {
-            rowdefs.inits.push_back(text.substr(4));
-        } else if (text == "|") {
-            rowdefs.offset = i + 1;
-            foundBar = true;
-            break;
-        }
-        ++i;
-    }
-
-    if (!foundBar) {
-        logg.msg(ERROR, "no bar separator '|' found in perRow pattern");
-         if (debug_y) {logg.debug("changed stop execution (perRow): " + to_string(stopExecution) + "->9");};
-        stopExecution = 9;
-    }
-    return rowdefs;
-  }
-
-vector<Rowitem> Interpreter::getPerRowItems(int start, vector<string>& v) {
-    vector<Rowitem> result;
-    for (int i=start; i<(int) v.size(); ++i) {
-        if (isExtended || (v[i] != "#rend")) {
-            Rowitem rowitem = Rowitem(v[i]);
-            result.push_back(rowitem);
-        }
-    }
-    return result;
-  }
-
-tuple<int, vector<string>> Interpreter::executeCombineSentence(string name, bool isStandardVerb, int jump, string stype,
-                      vector<string> &thislist, vector<string> &dolist, vector<string> &forlist, vector<string> &uselist, vector<string> &withlist, int stackLevel) {
+tuple<int, List> Interpreter::executeCombineSentence(Item &verb, int jump, string stype,
+                      List &thislist, List &dolist, List &forlist, List &uselist, List &withlist, int stackLevel) {
    		 if (debug_t) {logg.debugtime("@init");};
+        string name = verb.getName();
         int offset = 1;
-        vector<string> p;
+        List p;
 		vector<string> result;
-        int uselen = uselist.size();
-        int forlen = forlist.size();
-        int withlen = withlist.size();
-        int dolen = dolist.size();
-        int uoff = 0;
-        int foff = 0;
-        int woff = 0;
-		vector<string> bhelp;
-		string shelp = "";
-		string thelp = "";
-		bool hasUse = false;
-		bool hasFor = false;
-		bool hasWith = false;
-		bool goon = true;
-		while (goon) {
-			bhelp.clear();
-		  	for (int j=0; j<dolen; ++j) {
-		  		thelp = dolist[j];
-				if (thelp[0] == '#') {
-					thelp = thelp.substr(1);
-					if (thelp == "u") {
-						if (uoff <uselen) {
-							shelp = uselist[uoff];
-							bhelp.push_back(shelp);
-							++uoff;
-							hasUse = true;
-						} else {
-						    goon = false;
-						    break;
- 						}
-					} else if (thelp == "f") {
-						if (foff <forlen) {
-							shelp = forlist[foff];
-							bhelp.push_back(shelp);
-							++foff;
-							hasFor = true;
-						} else {
-   						    goon = false;
-						    break;
- 						}
-					} else if (thelp == "w") {
-						if (woff <withlen) {
-							shelp = withlist[woff];
-							bhelp.push_back(shelp);
-							++woff;
-							hasWith = true;
-						} else {
-   						    goon = false;
-						    break;
- 						}
-					} else {
-                        // do nothing, # is ignored
-					}
-				} else {
-					bhelp.push_back(thelp);
-				}
-		  	}
-
-		  	if (goon) {
-                vector<string> fl;
-                vector<string> ul;
-                vector<string> wl;
-                if (!hasFor) {fl = forlist;}
-                if (!hasUse) {ul=uselist;}
-                if (!hasWith) {wl=withlist;}
-                tie(offset, p) = executePlainVerb(name, isStandardVerb, jump, stype, thislist, bhelp, fl, ul, wl, stackLevel);
-                addToVector(result, p);
+        // a pattern of plain values is parsed by the fourth parse
+        Combineplan *plan = verb.getCombineplan();
+        unique_ptr<Combineplan> parsed;
+        if (plan == nullptr) {
+            parsed = make_unique<Combineplan>(dolist.vec());
+            plan = parsed.get();
+        }
+        // the lists taken by the pattern are not passed to the verb
+        List none;
+        List &fl = (plan->fors > 0) ? none : forlist;
+        List &ul = (plan->uses > 0) ? none : uselist;
+        List &wl = (plan->withs > 0) ? none : withlist;
+        long long int combinations = plan->combinations(uselist.size(), forlist.size(), withlist.size());
+        if (isParallel(verb, combinations)) {
+            offset = jump;
+            executeRowsParallel(combinations, thislist, fl, ul, wl, false, name, result,
+                [&](Interpreter &helper, int c, List *pa, List &rp) {
+                    vector<string> row;
+                    plan->build(c, uselist, forlist, withlist, row);
+                    List prow(move(row));
+                    int off;
+                    tie(off, rp) = helper.executePlainVerb(verb, jump, stype, pa[0], prow, pa[1], pa[2], pa[3], stackLevel);
+                    return true;
+                });
+        } else {
+            vector<string> bhelp;
+            for (long long int c = 0; (combinations < 0) || (c < combinations); ++c) {
+                plan->build(c, uselist, forlist, withlist, bhelp);
+                List row(move(bhelp));
+                tie(offset, p) = executePlainVerb(verb, jump, stype, thislist, row, fl, ul, wl, stackLevel);
+                result.insert(result.end(), p.begin(), p.end());
 
                 if (stopExecution>0) {break;}
-		  	}
-		}
+            }
+        }
 
     stopExecution = newStopExecution(stopExecution, LOOP);
      if (debug_t) {logg.debugtime("time for " + name + "-combine: ");};
-    return make_tuple(offset, result);
+    return make_tuple(offset, List(move(result)));
   }
 
-vector<string> Interpreter::vminus(vector<string> a, vector<string> b) {
+// modifier parallel: the paragraph is called for every chunk of the dolist (chunkN elements or one chunk per thread),
+// the results are joined in the order of the chunks and passed to the paragraph of modifier reduce (if given)
+tuple<int, List> Interpreter::executeParallelSentence(Item &verb, int jump,
+                      List &thislist, List &dolist, List &forlist, List &uselist, List &withlist, int stackLevel) {
+    if (debug_t) {logg.debugtime("@init");};
+    string name = verb.getName();
+    vector<string> result;
+    int len = dolist.size();
+    int size = verb.getChunk();
+    if (size == 0) {size = max(1, (len + pool->getThreads() - 1) / pool->getThreads());}
+    int chunks = max(1, (len + size - 1) / size);
+    if (debug_b) {logg.msg(DEBUG, "starting " + to_string(chunks) + " chunks of " + name);};
+    if (isParallel(verb, chunks)) {
+        executeRowsParallel(chunks, thislist, forlist, uselist, withlist, false, name, result,
+            [&](Interpreter &helper, int c, List *pa, List &rp) {
+                List chunk = dolist.slice(c * size, min(len, (c + 1) * size));
+                rp = helper.execParagraph(verb.getParaIndex(), pa[0], chunk, pa[1], pa[2], pa[3], stackLevel + 1, verb.hasMemo());
+                return true;
+            });
+    } else {
+        for (int c = 0; c < chunks; ++c) {
+            List chunk = dolist.slice(c * size, min(len, (c + 1) * size));
+            List p = execParagraph(verb.getParaIndex(), thislist, chunk, forlist, uselist, withlist, stackLevel + 1, verb.hasMemo());
+            result.insert(result.end(), p.begin(), p.end());
+            if (stopExecution > 0) {break;}
+        }
+    }
+    stopExecution = newStopExecution(stopExecution, LOOP);
+    List p(move(result));
+    if ((verb.getReduceIndex() >= 0) && (stopExecution == 0)) {
+        p = execParagraph(verb.getReduceIndex(), thislist, p, forlist, uselist, withlist, stackLevel + 1, false);
+    }
+    if (debug_t) {logg.debugtime("time for " + name + "-parallel: ");};
+    return make_tuple(jump, p);
+}
+
+vector<string> Interpreter::vminus(const vector<string> &a, const vector<string> &b) {
     vector<string> c;
     vector<string> d;
 
@@ -1340,7 +2061,7 @@ vector<string> Interpreter::vminus(vector<string> a, vector<string> b) {
     return c;
   }
 
-void Interpreter::doPrint(vector<string> v, bool withCrlf) {
+void Interpreter::doPrint(const vector<string> &v, bool withCrlf) {
     int len = v.size();
     bool suppress = false;
     for (int i = 0; i < len; ++i) {
@@ -1353,7 +2074,7 @@ void Interpreter::doPrint(vector<string> v, bool withCrlf) {
     if (withCrlf) {printf("\n");}
   }
 
-void Interpreter::doOut(vector<string> v, bool withCrlf) {
+void Interpreter::doOut(const vector<string> &v, bool withCrlf) {
     //setlocale(LC_ALL, "de_DE.UTF-8");
     //cout.imbue(mylocale);
     int len = v.size();
@@ -1445,912 +2166,980 @@ vector<string> Interpreter::fileop(string op, string filename) {
     return result;
 }
 
-vector<string> Interpreter::bulkExecLong(Modes mode, vector<string> &ops, vector<string> &liste, vector<string> &uselist, vector<string> &withlist) {
+// the results are returned together with their values, so that the next verb need not parse them
+// with the option -threads=N the rows are executed in chunks by the threads of the pool
+List Interpreter::bulkExecLong(Modes mode, const List &ops, const List &liste, const List &uselist, const List &withlist,
+                              Program *program) {
      if (debug_t) {logg.debugtime( "@init");};
-    vector<Opcode> codes = toOpcode(ops);
+    Program local;
+    Program &prog = getProgram(program, ops, local);
     vector<string> result;
+    vector<long long int> values;
     int len = (mode == MULTI) ? liste.size() : 1;
-    int i = 0;
-    vector<long long int> ihelp;
+    const long long int *lv = (mode == MULTI) ? liste.longValues() : nullptr;
+    int incr = prog.incr;
+    int maxvar = (mode == MULTI) ? prog.maxvar : 1;
+
+    if (prog.hasPrefix && (mode == SINGLE)) {
+        logg.msg(ERROR, "Opcodes row/def not allowed in pexpr.");
+        return List();
+    }
+     if (debug_b) {logg.debug("plist long, len= " + to_string(len) + ", maxvar = " + to_string(maxvar));};
+
+    int rows = ((incr > 0) && (len >= maxvar)) ? (len - maxvar) / incr + 1 : 0;
+    int n = countChunks(mode, rows, incr);
+    vector<Chunk> chunks(n);
+
+    // straight-line programs are executed column by column
+    bool done = false;
+    if ((mode == MULTI) && prog.longKernel && (incr > 0)) {
+        pool->run(n, [&](int c) {
+            Chunk &ch = chunks[c];
+            Kernel kernel(prog, exactMath);
+            if (prog.outs > 0) {
+                ch.result.reserve(prog.outs * ((c + 1) * rows / n - c * rows / n));
+                ch.values.reserve(ch.result.capacity());
+            }
+            ch.kernel = kernel.runLong(liste, lv, len, incr, c * rows / n, (c + 1) * rows / n, n == 1,
+                                       prog.hasdefault, prog.def, ch.result, ch.values);
+            if (rows > 0) {ch.sp = prog.depth;}
+        });
+        done = all_of(chunks.begin(), chunks.end(), [](const Chunk &ch) {return ch.kernel;});
+        if (!done) {chunks.assign(n, Chunk());}
+    }
+    if (!done) {
+        pool->run(n, [&](int c) {
+            int first = (n == 1) ? 0 : (c * rows / n) * incr;
+            int last = (n == 1) ? len - maxvar : ((c + 1) * rows / n - 1) * incr;
+            execRowsLong(mode, prog, ops, liste, uselist, withlist, lv, first, last, n == 1, chunks[c]);
+        });
+    }
+
+    if (!mergeChunks(mode, ops, "long", chunks, result, values)) {
+        return List();
+    }
+
+    if (mode == MULTI) {
+         if (debug_t) {logg.debugtime("time;bulk;long;");};
+    } else {
+         if (debug_t) {logg.debugtime("time;expr;long;");};
+    }
+
+    return List(move(result), move(values));
+}
+
+// executes the rows first..last of a plist (or the pexpr), the results and messages are collected in the chunk
+// without cache the parsed values are not stored in the lists, so that several threads can read them
+void Interpreter::execRowsLong(Modes mode, Program &prog, const List &ops, const List &liste, const List &uselist,
+                               const List &withlist, const long long int *lv, int first, int last, bool cache, Chunk &ch) {
+    const vector<Opcode> &codes = prog.codes;
+    const vector<Instr> &instrs = prog.instrs;
+    int n = instrs.size();
+    int len = (mode == MULTI) ? liste.size() : 1;
+    int i = first;
+    // operand stack, only programs with backward jumps may need to grow it
+    vector<long long int> stack(prog.stackSize);
+    long long int *st = stack.data();
+    int sp = 0;
+    bool growing = prog.backJump;
     long long int il;
     long long int ir;
     long long int i3;
-    int incr = 1;
-    bool hasdefault = false;
-    long long int def = 0;
-    int maxvar = (mode == MULTI) ? getRowLength(ops) : 1;
-    Opcode code = codes[0];
+    int incr = prog.incr;
+    bool hasdefault = prog.hasdefault;
+    long long int def = prog.def;
 
-    while ((code.op == ROW) || (code.op == DEFAULT)){
-        if (mode == SINGLE) {
-            logg.msg(ERROR, "Opcodes row/def not allowed in pexpr.");
-            return vempty;
-        } else if (code.op == ROW) {
-            incr = code.left;
-            codes.erase(codes.begin());
-             if (debug_b) {logg.debug("setting row incr to " + to_string(incr));};
-        } else if (code.op == DEFAULT) {
-            hasdefault = true;
-            def = code.left;
-            codes.erase(codes.begin());
-             if (debug_b) {logg.debug("setting default to " + to_string(def));};
-            maxvar = 1;
-        }
-        code = codes[0];
+    if ((mode == MULTI) && (prog.outs > 0) && (incr > 0) && (last >= first)) {
+        ch.result.reserve(prog.outs * ((last - first) / incr + 1));
+        ch.values.reserve(ch.result.capacity());
     }
-     if (debug_b) {logg.debug("plist long, len= " + to_string(len) + ", maxvar = " + to_string(maxvar));};
 
     try {
-        while(i<=len-maxvar) {
-            ihelp.clear();
-            int j = 0;
-            while (j<(int)codes.size()) {
-                code = codes[j];
-                if (ihelp.size() < code.operands) {
-                    if ((ihelp.size() == 1) && ((code.op == AND) || (code.op == OR) || (code.op == PLUS) || (code.op == TIMES)
-                        || (code.op == MIN)  || (code.op == MAX))) {
+        while (i <= last) {
+            sp = 0;
+            for (int j = 0; j < n; ++j) {
+                const Instr &in = instrs[j];
+                if (sp < (int) in.operands) {
+                    if ((sp == 1) && ((in.op == AND) || (in.op == OR) || (in.op == PLUS) || (in.op == TIMES)
+                        || (in.op == MIN)  || (in.op == MAX))) {
                             // do nothing, just skip operator
+                            continue;
                         } else {
-                            logg.msg(ERROR, "not enough operands for Opcode " + to_string(code.op));
-                            if (debug_y) {logg.debug("changed stop execution (missing operands): " + to_string(stopExecution) + "->9");};
-                            stopExecution = 9;
+                            ch.events.push_back({ERROR, "not enough operands for Opcode " + to_string(in.op), true});
                             break;
                         }
-                } else if (code.op == AND) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back(((ir>0) && (il>0)) ? 1 : 0);
-                } else if (code.op == OR) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back(((ir>0) || (il>0)) ? 1 : 0);
-                } else if (code.op == NOT) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back((ir == 0) ? 1 : 0);
-                } else if (code.op == ABS) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back((ir >= 0) ? ir : -ir);
-                }else if (code.op == PLUS) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back(il + ir);
-                } else if (code.op == MINUS) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back(il - ir);
-                } else if (code.op == TIMES) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back(il * ir);
-                } else if (code.op == DIVIDE) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back(il / ir);
-                } else if (code.op == MOD) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back(il % ir);
-                } else if (code.op == MAX) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   if (il > ir) {
-                    ihelp.push_back(il);
-                   } else {
-                    ihelp.push_back(ir);
-                   }
-                } else if (code.op == MIN) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   if (il < ir) {
-                    ihelp.push_back(il);
+                }
+                if (growing && (sp + 2 > (int) stack.size())) {
+                    stack.resize(2 * stack.size());
+                    st = stack.data();
+                }
+                switch (in.op) {
+                case AND:
+                   ir = st[--sp];
+                   st[sp-1] = ((ir>0) && (st[sp-1]>0)) ? 1 : 0;
+                   break;
+                case OR:
+                   ir = st[--sp];
+                   st[sp-1] = ((ir>0) || (st[sp-1]>0)) ? 1 : 0;
+                   break;
+                case NOT:
+                   st[sp-1] = (st[sp-1] == 0) ? 1 : 0;
+                   break;
+                case ABS:
+                   ir = st[sp-1];
+                   st[sp-1] = (ir >= 0) ? ir : -ir;
+                   break;
+                case PLUS:
+                   ir = st[--sp];
+                   st[sp-1] += ir;
+                   break;
+                case MINUS:
+                   ir = st[--sp];
+                   st[sp-1] -= ir;
+                   break;
+                case TIMES:
+                   ir = st[--sp];
+                   st[sp-1] *= ir;
+                   break;
+                case DIVIDE:
+                   ir = st[--sp];
+                   st[sp-1] /= ir;
+                   break;
+                case MOD:
+                   ir = st[--sp];
+                   st[sp-1] %= ir;
+                   break;
+                case MAX:
+                   ir = st[--sp];
+                   if (ir >= st[sp-1]) {st[sp-1] = ir;}
+                   break;
+                case MIN:
+                   ir = st[--sp];
+                   if (ir <= st[sp-1]) {st[sp-1] = ir;}
+                   break;
+                case DIV:
+                   ir = st[sp-1];
+                   il = st[sp-2];
+                   i3 = il % ir;
+                   st[sp-2] = (il - i3) / ir;
+                   st[sp-1] = i3;
+                   break;
+                case POWER:
+                   ir = st[--sp];
+                   st[sp-1] = lpower(st[sp-1], ir);
+                   break;
+                case EQ:
+                   ir = st[--sp];
+                   st[sp-1] = (st[sp-1] == ir) ? 1 : 0;
+                   break;
+                case NEQ:
+                   ir = st[--sp];
+                   st[sp-1] = (st[sp-1] != ir) ? 1 : 0;
+                   break;
+                case GE:
+                   ir = st[--sp];
+                   st[sp-1] = (st[sp-1] >= ir) ? 1 : 0;
+                   break;
+                case LE:
+                   ir = st[--sp];
+                   st[sp-1] = (st[sp-1] <= ir) ? 1 : 0;
+                   break;
+                case GT:
+                   ir = st[--sp];
+                   st[sp-1] = (st[sp-1] > ir) ? 1 : 0;
+                   break;
+                case LT:
+                   ir = st[--sp];
+                   st[sp-1] = (st[sp-1] < ir) ? 1 : 0;
+                   break;
+                case ELVIS:
+                   sp -= 2;
+                   st[sp-1] = (st[sp-1] > 0) ? st[sp] : st[sp+1];
+                   break;
+                case VAL:
+                   if (in.hasLong) {
+                       st[sp++] = in.lvalue;
                    } else {
-                    ihelp.push_back(ir);
+                       const Opcode &code = codes[in.code];
+                       st[sp++] = (code.pos >= 0) ? (cache ? ops.getLong(code.pos) : ops.peekLong(code.pos)) : stoll(code.sleft);
                    }
-                } else if (code.op == DIV) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   i3 = il % ir;
-                   il = (il - i3) / ir;
-                   ihelp.push_back(il);
-                   ihelp.push_back(i3);
-                } else if (code.op == POWER) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back(lpower(il, ir));
-                }else if (code.op == EQ) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back((il == ir) ? 1 : 0);
-                } else if (code.op == NEQ) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back((il != ir) ? 1 : 0);
-                } else if (code.op == GE) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back((il >= ir) ? 1 : 0);
-                } else if (code.op == LE) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back((il <= ir) ? 1 : 0);
-                } else if (code.op == GT) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back((il > ir) ? 1 : 0);
-                } else if (code.op == LT) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back((il < ir) ? 1 : 0);
-                } else if (code.op == ELVIS) {
-                   i3 =  ihelp.back();
-                   ihelp.pop_back();
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   il =  ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back(((il>0)) ? ir : i3);
-                } else if (code.op == VAL) {
-                   ihelp.push_back(stoll(code.sleft));
-                } else if (code.op == VAR) {
+                   break;
+                case VAR:
                     if (mode == SINGLE) {
-                        logg.msg(ERROR, "Opcode var not allowed in pexpr.");
-                        return vempty;
+                        ch.events.push_back({ERROR, "Opcode var not allowed in pexpr.", false});
+                        ch.failed = true;
+                        return;
                     }
 
-                    il = i + code.left - 1;
+                    il = i + in.left - 1;
 
                     if ((il < 0) || (il >= len)) {
                       if (hasdefault) {
-                        ihelp.push_back(def);
+                        st[sp++] = def;
                       } else {
-                        ihelp.push_back(0);
-                        logg.msg(ERROR, "non-existing index " + to_string(il) + " found and no default set.");
-                        return vempty;
+                        ch.events.push_back({ERROR, "non-existing index " + to_string(il) + " found and no default set.", false});
+                        ch.failed = true;
+                        return;
                       }
                     } else {
-                        ihelp.push_back(stoll(liste[il]));
+                        st[sp++] = lv ? lv[il] : (cache ? liste.getLong(il) : liste.peekLong(il));
                     }
-                } else if (code.op == IDX) {
+                    break;
+                case IDX:
                    if (mode == SINGLE) {
-                        logg.msg(ERROR, "Opcode idx not allowed in pexpr.");
-                        return vempty;
+                        ch.events.push_back({ERROR, "Opcode idx not allowed in pexpr.", false});
+                        ch.failed = true;
+                        return;
                    }
-                   ihelp.push_back(i+1);
-                } else if (code.op == UGET) {
+                   st[sp++] = i+1;
+                   break;
+                case UGET:
                    if (mode == SINGLE) {
-                        logg.msg(ERROR, "Opcode uget not allowed in pexpr.");
-                        return vempty;
+                        ch.events.push_back({ERROR, "Opcode uget not allowed in pexpr.", false});
+                        ch.failed = true;
+                        return;
                    }
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back(stoll(uselist[ir-1]));
-                } else if (code.op == WGET) {
+                   st[sp-1] = cache ? uselist.getLong(st[sp-1]-1) : uselist.peekLong(st[sp-1]-1);
+                   break;
+                case WGET:
                    if (mode == SINGLE) {
-                        logg.msg(ERROR, "Opcode wget not allowed in pexpr.");
-                        return vempty;
+                        ch.events.push_back({ERROR, "Opcode wget not allowed in pexpr.", false});
+                        ch.failed = true;
+                        return;
                    }
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   ihelp.push_back(stoll(withlist[ir-1]));
-                } else if (code.op == OUT) {
+                   st[sp-1] = cache ? withlist.getLong(st[sp-1]-1) : withlist.peekLong(st[sp-1]-1);
+                   break;
+                case OUT:
                     if (mode == SINGLE) {
-                        logg.msg(ERROR, "Opcode out not allowed in pexpr.");
-                        return vempty;
+                        ch.events.push_back({ERROR, "Opcode out not allowed in pexpr.", false});
+                        ch.failed = true;
+                        return;
                    }
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   result.push_back(to_string(ir));
-                } else if (code.op == DROP) {
-                   ihelp.pop_back();
-                } else if (code.op == END) {
-                   break;
-                } else if (code.op == SKIPZ) {
-                   ir = ihelp.back();
-                   ihelp.pop_back();
-                   if (ir == 0) {j+= code.left;}
+                   ir = st[--sp];
+                   ch.result.push_back(to_string(ir));
+                   ch.values.push_back(ir);
+                   break;
+                case DROP:
+                   --sp;
+                   break;
+                case END:
+                   j = n;
+                   break;
+                case SKIPZ:
+                   ir = st[--sp];
+                   if (ir == 0) {j+= in.left;}
+                   break;
+                default:
+                   // string and float opcodes are ignored
+                   break;
                 }
-                ++j;
             }
             i+= incr;
         }
 
     } catch (exception& e) {
-          logg.msg(FATAL, cstos(e.what()) + ": error when executing plist/pexpr-long for " + join(ops, " ") + " - ihelp.size = " + to_string(ihelp.size()));
-           if (debug_y) {logg.debug("changed stop execution (plist/pexpr-long): " + to_string(stopExecution) + "->9");};
-          stopExecution = 9;
+        ch.error = true;
+        ch.what = cstos(e.what());
     }
 
-    if (ihelp.size() > 0) {
-        if (mode == SINGLE) {
-            for (int i=0; i<(int) ihelp.size(); ++i) {
-               result.push_back(to_string(ihelp[i]));
-            }
-        } else {
-           logg.msg(WARNALL, "not all op results used for plist - " + to_string(ihelp.size()) + " left.");
+    if ((sp > 0) && (mode == SINGLE)) {
+        for (int i=0; i<sp; ++i) {
+           ch.result.push_back(to_string(st[i]));
+           ch.values.push_back(st[i]);
         }
     }
+    ch.sp = sp;
+}
+
+vector<string> Interpreter::bulkExecFloat(Modes mode, const List &ops, const List &liste, const List &uselist, const List &withlist,
+                                          Program *program) {
+     if (debug_t) {logg.debugtime( "@init");};
+    Program local;
+    Program &prog = getProgram(program, ops, local);
+    vector<string> result;
+    vector<long long int> values;
+    int len = (mode == MULTI) ? liste.size() : 1;
+    int incr = prog.incr;
+    int maxvar = (mode == MULTI) ? prog.maxvar : 1;
+
+    if (prog.hasPrefix && (mode == SINGLE)) {
+        logg.msg(ERROR, "Opcodes row/def not allowed in pexpr.");
+        return vempty;
+    }
+     if (debug_b) {logg.debug("plist/pexpr float, len= " + to_string(len) + ", maxvar = " + to_string(maxvar));};
+
+    int rows = ((incr > 0) && (len >= maxvar)) ? (len - maxvar) / incr + 1 : 0;
+    int n = countChunks(mode, rows, incr);
+    vector<Chunk> chunks(n);
+
+    // straight-line programs are executed column by column
+    bool done = false;
+    if ((mode == MULTI) && prog.floatKernel && (incr > 0)) {
+        pool->run(n, [&](int c) {
+            Chunk &ch = chunks[c];
+            Kernel kernel(prog, exactMath);
+            if (prog.outs > 0) {ch.result.reserve(prog.outs * ((c + 1) * rows / n - c * rows / n));}
+            ch.kernel = kernel.runFloat(liste, len, incr, c * rows / n, (c + 1) * rows / n, n == 1,
+                                        prog.hasdefault, prog.def, ch.result);
+            if (rows > 0) {ch.sp = prog.depth;}
+        });
+        done = all_of(chunks.begin(), chunks.end(), [](const Chunk &ch) {return ch.kernel;});
+        if (!done) {chunks.assign(n, Chunk());}
+    }
+    if (!done) {
+        pool->run(n, [&](int c) {
+            int first = (n == 1) ? 0 : (c * rows / n) * incr;
+            int last = (n == 1) ? len - maxvar : ((c + 1) * rows / n - 1) * incr;
+            execRowsFloat(mode, prog, ops, liste, uselist, withlist, first, last, n == 1, chunks[c]);
+        });
+    }
+
+    if (!mergeChunks(mode, ops, "float", chunks, result, values)) {
+        return vempty;
+    }
 
     if (mode == MULTI) {
-         if (debug_t) {logg.debugtime("time;bulk;long;");};
+         if (debug_t) {logg.debugtime("time;bulk;float;");};
     } else {
-         if (debug_t) {logg.debugtime("time;expr;long;");};
+         if (debug_t) {logg.debugtime("time;expr;float;");};
     }
 
     return result;
 }
 
-vector<string> Interpreter::bulkExecFloat(Modes mode, vector<string> &ops, vector<string> &liste, vector<string> &uselist, vector<string> &withlist) {
-     if (debug_t) {logg.debugtime( "@init");};
-    vector<Opcode> codes = toOpcode(ops);
-    vector<string> result;
+// executes the rows first..last of a plist (or the pexpr), see execRowsLong
+void Interpreter::execRowsFloat(Modes mode, Program &prog, const List &ops, const List &liste, const List &uselist,
+                                const List &withlist, int first, int last, bool cache, Chunk &ch) {
+    const vector<Opcode> &codes = prog.codes;
+    const vector<Instr> &instrs = prog.instrs;
+    int n = instrs.size();
     int len = (mode == MULTI) ? liste.size() : 1;
-    int i = 0;
-    vector<double> dhelp;
+    int i = first;
+    // operand stack, only programs with backward jumps may need to grow it
+    vector<double> stack(prog.stackSize);
+    double *st = stack.data();
+    int sp = 0;
+    bool growing = prog.backJump;
     double dl;
     double dr;
     double d3;
-    int incr = 1;
+    int incr = prog.incr;
     int ihelp = 0;
-    bool hasdefault = false;
-    double def = 0.0;
-    int maxvar = (mode == MULTI) ? getRowLength(ops) : 1;
-    Opcode code = codes[0];
+    bool hasdefault = prog.hasdefault;
+    double def = prog.def;
 
-    while ((code.op == ROW) || (code.op == DEFAULT)){
-        if (mode == SINGLE) {
-            logg.msg(ERROR, "Opcodes row/def not allowed in pexpr.");
-            return vempty;
-        } else if (code.op == ROW) {
-            incr = code.left;
-            codes.erase(codes.begin());
-             if (debug_b) {logg.debug("setting row incr to " + to_string(incr));};
-        } else if (code.op == DEFAULT) {
-            hasdefault = true;
-            def = code.left;
-            codes.erase(codes.begin());
-             if (debug_b) {logg.debug("setting default to " + to_string(def));};
-            maxvar = 1;
-        }
-        code = codes[0];
+    if ((mode == MULTI) && (prog.outs > 0) && (incr > 0) && (last >= first)) {
+        ch.result.reserve(prog.outs * ((last - first) / incr + 1));
     }
-     if (debug_b) {logg.debug("plist/pexpr float, len= " + to_string(len) + ", maxvar = " + to_string(maxvar));};
 
     try {
-        while(i<=len-maxvar) {
-            dhelp.clear();
-            int j = 0;
-            while (j<(int)codes.size()) {
-                code = codes[j];
-                if (dhelp.size() < code.operands) {
-                    if ((dhelp.size() == 1) && ((code.op == AND) || (code.op == OR) || (code.op == PLUS) || (code.op == TIMES)
-                        || (code.op == MIN)  || (code.op == MAX))) {
+        while (i <= last) {
+            sp = 0;
+            for (int j = 0; j < n; ++j) {
+                const Instr &in = instrs[j];
+                if (sp < (int) in.operands) {
+                    if ((sp == 1) && ((in.op == AND) || (in.op == OR) || (in.op == PLUS) || (in.op == TIMES)
+                        || (in.op == MIN)  || (in.op == MAX))) {
                             // do nothing, just skip operator
+                            continue;
                         } else {
-                            logg.msg(ERROR, "not enough operands for Opcode " + to_string(code.op));
-                            if (debug_y) {logg.debug("changed stop execution (missing operands): " + to_string(stopExecution) + "->9");};
-                            stopExecution = 9;
+                            ch.events.push_back({ERROR, "not enough operands for Opcode " + to_string(in.op), true});
                             break;
                         }
-                } else if (code.op == AND) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(((dr>0) && (dl>0)) ? 1 : 0);
-                } else if (code.op == OR) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(((dr>0) || (dl>0)) ? 1 : 0);
-                } else if (code.op == NOT) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back((dr == 0) ? 1 : 0);
-                } else if (code.op == ABS) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back((dr >= 0) ? dr : -dr);
-                } else if (code.op == CEIL) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(ceil(dr));
-                }  else if (code.op == FLOOR) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(floor(dr));
-                } else if (code.op == ROUND) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(round(dr));
-                } else if (code.op == SQRT) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(sqrt(dr));
-                } else if (code.op == SIN) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(sin(dr));
-                } else if (code.op == COS) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(cos(dr));
-                } else if (code.op == TAN) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(tan(dr));
-                } else if (code.op == ARCSIN) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(asin(dr));
-                } else if (code.op == ARCCOS) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(acos(dr));
-                } else if (code.op == ARCTAN) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(atan(dr));
-                } else if (code.op == EXP) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(exp(dr));
-                } else if (code.op == LOG) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(log(dr));
-                } else if (code.op == LOG10) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(log10(dr));
-                } else if (code.op == SINH) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(sinh(dr));
-                } else if (code.op == COSH) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(cosh(dr));
-                } else if (code.op == TANH) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(tanh(dr));
-                } else if (code.op == PLUS) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(dl + dr);
-                } else if (code.op == MINUS) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(dl - dr);
-                } else if (code.op == TIMES) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(dl * dr);
-                } else if (code.op == DIVIDE) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(dl / dr);
-                } else if (code.op == MOD) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
+                }
+                if (growing && (sp + 2 > (int) stack.size())) {
+                    stack.resize(2 * stack.size());
+                    st = stack.data();
+                }
+                switch (in.op) {
+                case AND:
+                   dr = st[--sp];
+                   st[sp-1] = ((dr>0) && (st[sp-1]>0)) ? 1 : 0;
+                   break;
+                case OR:
+                   dr = st[--sp];
+                   st[sp-1] = ((dr>0) || (st[sp-1]>0)) ? 1 : 0;
+                   break;
+                case NOT:
+                   st[sp-1] = (st[sp-1] == 0) ? 1 : 0;
+                   break;
+                case ABS:
+                   dr = st[sp-1];
+                   st[sp-1] = (dr >= 0) ? dr : -dr;
+                   break;
+                case CEIL:
+                   st[sp-1] = ceil(st[sp-1]);
+                   break;
+                case FLOOR:
+                   st[sp-1] = floor(st[sp-1]);
+                   break;
+                case ROUND:
+                   st[sp-1] = round(st[sp-1]);
+                   break;
+                case SQRT:
+                   st[sp-1] = sqrt(st[sp-1]);
+                   break;
+                case SIN:
+                   st[sp-1] = sin(st[sp-1]);
+                   break;
+                case COS:
+                   st[sp-1] = cos(st[sp-1]);
+                   break;
+                case TAN:
+                   st[sp-1] = tan(st[sp-1]);
+                   break;
+                case ARCSIN:
+                   st[sp-1] = asin(st[sp-1]);
+                   break;
+                case ARCCOS:
+                   st[sp-1] = acos(st[sp-1]);
+                   break;
+                case ARCTAN:
+                   st[sp-1] = atan(st[sp-1]);
+                   break;
+                case EXP:
+                   st[sp-1] = exp(st[sp-1]);
+                   break;
+                case LOG:
+                   st[sp-1] = log(st[sp-1]);
+                   break;
+                case LOG10:
+                   st[sp-1] = log10(st[sp-1]);
+                   break;
+                case SINH:
+                   st[sp-1] = sinh(st[sp-1]);
+                   break;
+                case COSH:
+                   st[sp-1] = cosh(st[sp-1]);
+                   break;
+                case TANH:
+                   st[sp-1] = tanh(st[sp-1]);
+                   break;
+                case PLUS:
+                   dr = st[--sp];
+                   st[sp-1] += dr;
+                   break;
+                case MINUS:
+                   dr = st[--sp];
+                   st[sp-1] -= dr;
+                   break;
+                case TIMES:
+                   dr = st[--sp];
+                   st[sp-1] *= dr;
+                   break;
+                case DIVIDE:
+                   dr = st[--sp];
+                   st[sp-1] /= dr;
+                   break;
+                case MOD:
+                   dr = st[--sp];
+                   st[sp-1] = (int) round(st[sp-1]) % (int) round(dr);
+                   break;
+                case MAX:
+                   dr = st[--sp];
+                   if (!(st[sp-1] > dr)) {st[sp-1] = dr;}
+                   break;
+                case MIN:
+                   dr = st[--sp];
+                   if (!(st[sp-1] < dr)) {st[sp-1] = dr;}
+                   break;
+                case DIV:
+                   dr = st[sp-1];
+                   dl = st[sp-2];
                    d3 = (int) round(dl) % (int) round(dr);
-                   dhelp.push_back(d3);
-                } else if (code.op == MAX) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   if (dl > dr) {
-                    dhelp.push_back(dl);
-                   } else {
-                    dhelp.push_back(dr);
-                   }
-                } else if (code.op == MIN) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   if (dl < dr) {
-                    dhelp.push_back(dl);
+                   st[sp-2] = (dl - d3) / dr;
+                   st[sp-1] = d3;
+                   break;
+                case POWER:
+                   dr = st[--sp];
+                   st[sp-1] = pow(st[sp-1], dr);
+                   break;
+                case EQ:
+                   dr = st[--sp];
+                   st[sp-1] = (st[sp-1] == dr) ? 1 : 0;
+                   break;
+                case NEQ:
+                   dr = st[--sp];
+                   st[sp-1] = (st[sp-1] != dr) ? 1 : 0;
+                   break;
+                case GE:
+                   dr = st[--sp];
+                   st[sp-1] = (st[sp-1] >= dr) ? 1 : 0;
+                   break;
+                case LE:
+                   dr = st[--sp];
+                   st[sp-1] = (st[sp-1] <= dr) ? 1 : 0;
+                   break;
+                case GT:
+                   dr = st[--sp];
+                   st[sp-1] = (st[sp-1] > dr) ? 1 : 0;
+                   break;
+                case LT:
+                   dr = st[--sp];
+                   st[sp-1] = (st[sp-1] < dr) ? 1 : 0;
+                   break;
+                case ELVIS:
+                   sp -= 2;
+                   st[sp-1] = (st[sp-1] > 0) ? st[sp] : st[sp+1];
+                   break;
+                case VAL:
+                   if (in.hasDouble) {
+                       st[sp++] = in.dvalue;
                    } else {
-                    dhelp.push_back(dr);
+                       const Opcode &code = codes[in.code];
+                       st[sp++] = (code.pos >= 0) ? (cache ? ops.getDouble(code.pos) : ops.peekDouble(code.pos)) : stod(code.sleft);
                    }
-                } else if (code.op == DIV) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   d3 = (int) round(dl) % (int) round(dr);
-                   dl = (dl - d3) / dr;
-                   dhelp.push_back(dl);
-                   dhelp.push_back(d3);
-                } else if (code.op == POWER) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(pow(dl, dr));
-                }else if (code.op == EQ) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back((dl == dr) ? 1 : 0);
-                } else if (code.op == NEQ) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back((dl != dr) ? 1 : 0);
-                } else if (code.op == GE) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back((dl >= dr) ? 1 : 0);
-                } else if (code.op == LE) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back((dl <= dr) ? 1 : 0);
-                } else if (code.op == GT) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back((dl > dr) ? 1 : 0);
-                } else if (code.op == LT) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back((dl < dr) ? 1 : 0);
-                } else if (code.op == ELVIS) {
-                   d3 =  dhelp.back();
-                   dhelp.pop_back();
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   dl =  dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(((dl>0)) ? dr : d3);
-                } else if (code.op == VAL) {
-                   dhelp.push_back(stod(code.sleft));
-                } else if (code.op == VAR) {
+                   break;
+                case VAR:
                     if (mode == SINGLE) {
-                        logg.msg(ERROR, "Opcode var not allowed in pexpr.");
-                        return vempty;
+                        ch.events.push_back({ERROR, "Opcode var not allowed in pexpr.", false});
+                        ch.failed = true;
+                        return;
                     }
 
-                    ihelp = i + code.left - 1;
+                    ihelp = i + in.left - 1;
 
                     if ((ihelp < 0) || (ihelp >= len)) {
                       if (hasdefault) {
-                        dhelp.push_back(def);
+                        st[sp++] = def;
                       } else {
-                        dhelp.push_back(0.0);
-                        logg.msg(ERROR, "non-existing index " + to_string(ihelp) + " found and no default set.");
-                        return vempty;
+                        ch.events.push_back({ERROR, "non-existing index " + to_string(ihelp) + " found and no default set.", false});
+                        ch.failed = true;
+                        return;
                       }
                     } else {
-                        dhelp.push_back(stod(liste[ihelp]));
+                        st[sp++] = cache ? liste.getDouble(ihelp) : liste.peekDouble(ihelp);
                     }
-
-
-                } else if (code.op == IDX) {
+                    break;
+                case IDX:
                    if (mode == SINGLE) {
-                        logg.msg(ERROR, "Opcode idx not allowed in pexpr.");
-                        return vempty;
+                        ch.events.push_back({ERROR, "Opcode idx not allowed in pexpr.", false});
+                        ch.failed = true;
+                        return;
                    }
-                   dhelp.push_back(i+1);
-                } else if (code.op == UGET) {
+                   st[sp++] = i+1;
+                   break;
+                case UGET:
                    if (mode == SINGLE) {
-                        logg.msg(ERROR, "Opcode uget not allowed in pexpr.");
-                        return vempty;
+                        ch.events.push_back({ERROR, "Opcode uget not allowed in pexpr.", false});
+                        ch.failed = true;
+                        return;
                    }
-                   ihelp = (int) dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(stod(uselist[ihelp - 1]));
-                } else if (code.op == WGET) {
+                   ihelp = (int) st[sp-1];
+                   st[sp-1] = cache ? uselist.getDouble(ihelp - 1) : uselist.peekDouble(ihelp - 1);
+                   break;
+                case WGET:
                    if (mode == SINGLE) {
-                        logg.msg(ERROR, "Opcode wget not allowed in pexpr.");
-                        return vempty;
+                        ch.events.push_back({ERROR, "Opcode wget not allowed in pexpr.", false});
+                        ch.failed = true;
+                        return;
                    }
-                   ihelp = (int) dhelp.back();
-                   dhelp.pop_back();
-                   dhelp.push_back(stod(withlist[ihelp-1]));
-                } else if (code.op == OUT) {
+                   ihelp = (int) st[sp-1];
+                   st[sp-1] = cache ? withlist.getDouble(ihelp - 1) : withlist.peekDouble(ihelp - 1);
+                   break;
+                case OUT:
                     if (mode == SINGLE) {
-                        logg.msg(ERROR, "Opcode out not allowed in pexpr.");
-                        return vempty;
+                        ch.events.push_back({ERROR, "Opcode out not allowed in pexpr.", false});
+                        ch.failed = true;
+                        return;
                    }
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   result.push_back(to_string(dr));
-                } else if (code.op == DROP) {
-                   dhelp.pop_back();
-                } else if (code.op == END) {
-                   break;
-                } else if (code.op == SKIPZ) {
-                   dr = dhelp.back();
-                   dhelp.pop_back();
-                   if (dr == 0) {j+= code.left;}
+                   ch.result.push_back(to_string(st[--sp]));
+                   break;
+                case DROP:
+                   --sp;
+                   break;
+                case END:
+                   j = n;
+                   break;
+                case SKIPZ:
+                   dr = st[--sp];
+                   if (dr == 0) {j+= in.left;}
+                   break;
+                default:
+                   // string opcodes are ignored
+                   break;
                 }
-                ++j;
             }
             i+= incr;
         }
 
     } catch (exception& e) {
-          logg.msg(FATAL, cstos(e.what()) + ": error when executing plist/pexpr-float for " + join(ops, " ") + " - ihelp.size = " + to_string(dhelp.size()));
-           if (debug_y) {logg.debug("changed stop execution (plist/pexpr): " + to_string(stopExecution) + "->9");};
-          stopExecution = 9;
+        ch.error = true;
+        ch.what = cstos(e.what());
     }
 
-    if (dhelp.size() > 0) {
-        if (mode == SINGLE) {
-            for (int i=0; i<(int) dhelp.size(); ++i) {
-               result.push_back(to_string(dhelp[i]));
+    if ((sp > 0) && (mode == SINGLE)) {
+        for (int i=0; i<sp; ++i) {
+           ch.result.push_back(to_string(st[i]));
+        }
+    }
+    ch.sp = sp;
+}
+
+// number of chunks for the rows of a plist, only plists with enough rows are executed by several threads
+int Interpreter::countChunks(Modes mode, int rows, int incr) {
+    int threads = pool->getThreads();
+    if ((mode != MULTI) || (incr <= 0) || (threads <= 1) || (rows < 2 * MIN_ROWS)) {
+        return 1;
+    }
+    return min(threads * 4, rows / MIN_ROWS);
+}
+
+// appends the results of the chunks in the order of the rows and logs their messages,
+// so that a plist executed by several threads behaves like one executed row by row.
+// returns false if the plist has no result (e.g. var in pexpr)
+bool Interpreter::mergeChunks(Modes mode, const List &ops, string stype, vector<Chunk> &chunks,
+                              vector<string> &result, vector<long long int> &values) {
+    int sp = 0;
+    if (chunks.size() > 1) {
+        size_t total = 0;
+        for (Chunk &ch : chunks) {total += ch.result.size();}
+        result.reserve(total);
+        values.reserve(total);
+    }
+    for (Chunk &ch : chunks) {
+        for (Event &ev : ch.events) {
+            logg.msg(ev.level, ev.text);
+            if (ev.stop) {
+                if (debug_y) {logg.debug("changed stop execution (missing operands): " + to_string(stopExecution) + "->9");};
+                stopExecution = 9;
             }
+        }
+        if (ch.failed) {
+            return false;
+        }
+        if (chunks.size() == 1) {
+            result = move(ch.result);
+            values = move(ch.values);
         } else {
-           logg.msg(WARNALL, "not all op results used for plist - " + to_string(dhelp.size()) + " left.");
+            result.insert(result.end(), make_move_iterator(ch.result.begin()), make_move_iterator(ch.result.end()));
+            values.insert(values.end(), ch.values.begin(), ch.values.end());
+        }
+        sp = ch.sp;
+        if (ch.error) {
+            // the rows after the error are not executed by a serial execution either
+            logg.msg(FATAL, ch.what + ": error when executing plist/pexpr-" + stype + " for " + join(ops.vec(), " ") + " - ihelp.size = " + to_string(sp));
+            if (debug_y) {logg.debug("changed stop execution (plist/pexpr-" + stype + "): " + to_string(stopExecution) + "->9");};
+            stopExecution = 9;
+            break;
         }
     }
 
-    if (mode == MULTI) {
-         if (debug_t) {logg.debugtime("time;bulk;float;");};
-    } else {
-         if (debug_t) {logg.debugtime("time;expr;float;");};
+    if ((sp > 0) && (mode == MULTI)) {
+        logg.msg(WARNALL, "not all op results used for plist - " + to_string(sp) + " left.");
     }
-
-    return result;
+    return true;
 }
 
-vector<string> Interpreter::bulkExecString(Modes mode, vector<string> &ops, vector<string> &liste, vector<string> &uselist, vector<string> &withlist) {
+// the operand stack holds views on the list elements, the opcode values and the constants "0" and "1".
+// Computed strings are kept per stack position (buf) and reused for the next rows, so that a row does not
+// allocate memory except for its outputs.
+vector<string> Interpreter::bulkExecString(Modes mode, const List &ops, const List &liste, const List &uselist, const List &withlist,
+                                           Program *program) {
      if (debug_t) {logg.debugtime("@init");};
-    vector<Opcode> codes = toOpcode(ops);
+    static const string_view ZERO = "0";
+    static const string_view ONE = "1";
+    Program local;
+    Program &prog = getProgram(program, ops, local);
+    const vector<Opcode> &codes = prog.codes;
+    const vector<Instr> &instrs = prog.instrs;
+    int n = instrs.size();
     vector<string> result;
     int len = (mode == MULTI) ? liste.size() : 1;
     int i = 0;
     int il = 0;
-    vector<string> shelp;
-    string sl;
-    string sr;
-    string s3;
-    int incr = 1;
-    int maxvar = (mode == MULTI) ? getRowLength(ops) : 1;
-    Opcode code = codes[0];
-    bool hasdefault = false;
-    string def = "";
-
-    while ((code.op == ROW) || (code.op == DEFAULT)){
-        if (mode == SINGLE) {
-            logg.msg(ERROR, "Opcodes row/def not allowed in pexpr.");
-            return vempty;
-        } else if (code.op == ROW) {
-            incr = code.left;
-            codes.erase(codes.begin());
-             if (debug_b) {logg.debug("setting row incr to " + to_string(incr));};
-        } else if (code.op == DEFAULT) {
-            hasdefault = true;
-            def = code.sleft;
-            codes.erase(codes.begin());
-             if (debug_b) {logg.debug("setting default to " + def);};
-            maxvar = 1;
-        }
-        code = codes[0];
+    // operand stack, only programs with backward jumps may need to grow it
+    // st[k] is a view on buf[k] if own[k] is set
+    vector<string_view> stack(prog.stackSize);
+    vector<string> buf(prog.stackSize);
+    vector<char> own(prog.stackSize);
+    string_view *st = stack.data();
+    int sp = 0;
+    bool growing = prog.backJump;
+    string_view sl;
+    string_view sr;
+    string num; // copy of an operand for stoll, stoi and isLong
+    int incr = prog.incr;
+    int maxvar = (mode == MULTI) ? prog.maxvar : 1;
+    bool hasdefault = prog.hasdefault;
+    const string &def = prog.sdef;
+
+    // the string of operand k, which can be changed in place (st[k] must be set again if its length changes)
+    auto text = [&](int k) -> string& {
+        if (!own[k]) {
+            buf[k].assign(st[k]);
+            st[k] = buf[k];
+            own[k] = 1;
+        }
+        return buf[k];
+    };
+    // operand k becomes the number v, written like to_string
+    auto setNumber = [&](int k, long long int v) {
+        char c[24];
+        buf[k].assign(c, to_chars(c, c + sizeof(c), v).ptr);
+        st[k] = buf[k];
+        own[k] = 1;
+    };
+    // operand k becomes a copy of operand m (m > k)
+    auto setCopy = [&](int k, int m) {
+        if (own[m]) {
+            buf[k].assign(st[m]);
+            st[k] = buf[k];
+        } else {
+            st[k] = st[m];
+        }
+        own[k] = own[m];
+    };
+    auto setFlag = [&](int k, bool b) {
+        st[k] = b ? ONE : ZERO;
+        own[k] = 0;
+    };
+    // numeric operands are popped before they are parsed (the stack size is part of the error message)
+    auto toLong = [&](string_view s) {
+        num.assign(s);
+        return stoll(num);
+    };
+    auto bothLong = [&](string_view a, string_view b) {
+        num.assign(a);
+        if (!isLong(num)) {return false;}
+        num.assign(b);
+        return isLong(num);
+    };
+
+    if (prog.hasPrefix && (mode == SINGLE)) {
+        logg.msg(ERROR, "Opcodes row/def not allowed in pexpr.");
+        return vempty;
     }
      if (debug_b) {logg.debug("plist/pexpr string, len= " + to_string(len) + ", maxvar = " + to_string(maxvar));};
 
+    if ((mode == MULTI) && (prog.outs > 0) && (incr > 0) && (len >= maxvar)) {
+        result.reserve(prog.outs * ((len - maxvar) / incr + 1));
+    }
+
     try {
          while(i<=len-maxvar) {
-            shelp.clear();
-            int j = 0;
-            while (j<(int)codes.size()) {
-                code = codes[j];
-                if (shelp.size() < code.operands) {
-                    if ((shelp.size() == 1) && ((code.op == AND) || (code.op == OR) || (code.op == PLUS) || (code.op == TIMES)
-                        || (code.op == MIN)  || (code.op == MAX))) {
+            sp = 0;
+            for (int j = 0; j < n; ++j) {
+                const Instr &in = instrs[j];
+                if (sp < (int) in.operands) {
+                    if ((sp == 1) && ((in.op == AND) || (in.op == OR) || (in.op == PLUS) || (in.op == TIMES)
+                        || (in.op == MIN)  || (in.op == MAX))) {
                             // do nothing, just skip operator
+                            continue;
                         } else {
-                            logg.msg(ERROR, "not enough operands for Opcode " + to_string(code.op));
+                            logg.msg(ERROR, "not enough operands for Opcode " + to_string(in.op));
                             if (debug_y) {logg.debug("changed stop execution (missing operands): " + to_string(stopExecution) + "->9");};
                             stopExecution = 9;
                             break;
                         }
-                } else if (code.op == AND) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(((sr!="0") && (sl!="0")) ? "1" : "0");
-                } else if (code.op == OR) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(((sr!="0") || (sl!="0")) ? "1" : "0");
-                } else if (code.op == NOT) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back((sr == "0") ? "1" : "0");
-                } else if (code.op == ISINT) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(isInt(sr) ? "1" : "0");
-                } else if (code.op == ISNUM) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(isNumber(sr) ? "1" : "0");
-                } else if (code.op == LEN) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(to_string(sr.size()));
-                }else if (code.op == PLUS) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(to_string(stoll(sl) + stoll(sr)));
-                } else if (code.op == CONCAT) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(sl + sr);
-                } else if (code.op == MINUS) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(to_string(stoll(sl) - stoll(sr)));
-                } else if (code.op == DIVIDE) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(to_string(stoll(sl) / stoll(sr)));
-                } else if (code.op == MOD) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(to_string(stoll(sl) % stoll(sr)));
-                } else if (code.op == POWER) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(to_string(lpower(stoll(sl), stoll(sr))));
-                } else if (code.op == TIMES) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(to_string(stoll(sl) * stoll(sr)));
-                } else if (code.op == MAX) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   if (sl > sr) {
-                    shelp.push_back(sl);
-                   } else {
-                    shelp.push_back(sr);
-                   }
-                } else if (code.op == MIN) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   if (sl < sr) {
-                    shelp.push_back(sl);
-                   } else {
-                    shelp.push_back(sr);
-                   }
-                } else if (code.op == EQ) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back((sl == sr) ? "1" : "0");
-                 } else if (code.op == NEQ) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back((sl != sr) ? "1" : "0");
-                 } else if (code.op == GE) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   if (isLong(sr) && isLong(sl)) {
-                        shelp.push_back((stoll(sl) >= stoll(sr) ? "1" : "0"));
-                   } else {
-                        shelp.push_back(sl >= sr ? "1" : "0");
-                   }
-                 } else if (code.op == LE) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   if (isLong(sr) && isLong(sl)) {
-                        shelp.push_back((stoll(sl) <= stoll(sr) ? "1" : "0"));
-                   } else {
-                        shelp.push_back(sl <= sr ? "1" : "0");
-                   }
-                 } else if (code.op == GT) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   if (isLong(sr) && isLong(sl)) {
-                        shelp.push_back((stoll(sl) > stoll(sr) ? "1" : "0"));
-                   } else {
-                        shelp.push_back(sl > sr ? "1" : "0");
-                   }
-
-                 } else if (code.op == LT) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   if (isLong(sr) && isLong(sl)) {
-                        shelp.push_back((stoll(sl) < stoll(sr) ? "1" : "0"));
-                   } else {
-                        shelp.push_back(sl < sr ? "1" : "0");
-                   }
-                } else if (code.op == CONCAT) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(sl + sr);
-                } else if (code.op == ELVIS) {
-                   s3 =  shelp.back();
-                   shelp.pop_back();
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   sl =  shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(((sl!="0")) ? sr : s3);
-                } else if (code.op == VAL) {
-                   shelp.push_back(code.sleft);
-                } else if (code.op == IDX) {
-                     if (mode == SINGLE) {
+                }
+                if (growing && (sp + 2 > (int) stack.size())) {
+                    stack.resize(2 * stack.size());
+                    buf.resize(stack.size());
+                    own.resize(stack.size());
+                    st = stack.data();
+                    // the strings may have moved
+                    for (int k = 0; k < sp; ++k) {
+                        if (own[k]) {st[k] = buf[k];}
+                    }
+                }
+                switch (in.op) {
+                case AND:
+                   sr = st[--sp];
+                   setFlag(sp-1, (sr != ZERO) && (st[sp-1] != ZERO));
+                   break;
+                case OR:
+                   sr = st[--sp];
+                   setFlag(sp-1, (sr != ZERO) || (st[sp-1] != ZERO));
+                   break;
+                case NOT:
+                   setFlag(sp-1, st[sp-1] == ZERO);
+                   break;
+                case ISINT:
+                   num.assign(st[sp-1]);
+                   setFlag(sp-1, isInt(num));
+                   break;
+                case ISNUM:
+                   num.assign(st[sp-1]);
+                   setFlag(sp-1, isNumber(num));
+                   break;
+                case LEN:
+                   setNumber(sp-1, st[sp-1].size());
+                   break;
+                case PLUS:
+                   sp -= 2;
+                   setNumber(sp, toLong(st[sp]) + toLong(st[sp+1]));
+                   ++sp;
+                   break;
+                case MINUS:
+                   sp -= 2;
+                   setNumber(sp, toLong(st[sp]) - toLong(st[sp+1]));
+                   ++sp;
+                   break;
+                case TIMES:
+                   sp -= 2;
+                   setNumber(sp, toLong(st[sp]) * toLong(st[sp+1]));
+                   ++sp;
+                   break;
+                case DIVIDE:
+                   sp -= 2;
+                   setNumber(sp, toLong(st[sp]) / toLong(st[sp+1]));
+                   ++sp;
+                   break;
+                case MOD:
+                   sp -= 2;
+                   setNumber(sp, toLong(st[sp]) % toLong(st[sp+1]));
+                   ++sp;
+                   break;
+                case POWER:
+                   sp -= 2;
+                   setNumber(sp, lpower(toLong(st[sp]), toLong(st[sp+1])));
+                   ++sp;
+                   break;
+                case CONCAT:
+                   sr = st[--sp];
+                   st[sp-1] = text(sp-1).append(sr);
+                   break;
+                case MAX:
+                   --sp;
+                   if (!(st[sp-1] > st[sp])) {setCopy(sp-1, sp);}
+                   break;
+                case MIN:
+                   --sp;
+                   if (!(st[sp-1] < st[sp])) {setCopy(sp-1, sp);}
+                   break;
+                case EQ:
+                   sr = st[--sp];
+                   setFlag(sp-1, st[sp-1] == sr);
+                   break;
+                case NEQ:
+                   sr = st[--sp];
+                   setFlag(sp-1, st[sp-1] != sr);
+                   break;
+                case GE:
+                   sp -= 2;
+                   sl = st[sp];
+                   sr = st[sp+1];
+                   setFlag(sp++, bothLong(sr, sl) ? (toLong(sl) >= toLong(sr)) : (sl >= sr));
+                   break;
+                case LE:
+                   sp -= 2;
+                   sl = st[sp];
+                   sr = st[sp+1];
+                   setFlag(sp++, bothLong(sr, sl) ? (toLong(sl) <= toLong(sr)) : (sl <= sr));
+                   break;
+                case GT:
+                   sp -= 2;
+                   sl = st[sp];
+                   sr = st[sp+1];
+                   setFlag(sp++, bothLong(sr, sl) ? (toLong(sl) > toLong(sr)) : (sl > sr));
+                   break;
+                case LT:
+                   sp -= 2;
+                   sl = st[sp];
+                   sr = st[sp+1];
+                   setFlag(sp++, bothLong(sr, sl) ? (toLong(sl) < toLong(sr)) : (sl < sr));
+                   break;
+                case ELVIS:
+                   sp -= 2;
+                   setCopy(sp-1, (st[sp-1] != ZERO) ? sp : sp+1);
+                   break;
+                case VAL:
+                   st[sp] = codes[in.code].sleft;
+                   own[sp++] = 0;
+                   break;
+                case IDX:
+                    if (mode == SINGLE) {
                         logg.msg(ERROR, "Opcode idx not allowed in pexpr.");
                         return vempty;
                     }
-                    shelp.push_back(to_string(i+1));
-                } else if (code.op == VAR) {
-                     if (mode == SINGLE) {
+                    setNumber(sp++, i+1);
+                    break;
+                case VAR:
+                    if (mode == SINGLE) {
                         logg.msg(ERROR, "Opcode var not allowed in pexpr.");
                         return vempty;
                     }
-                    il = i + code.left - 1;
-
+                    il = i + in.left - 1;
                     if ((il < 0) || (il >= len)) {
                       if (hasdefault) {
-                        shelp.push_back(def);
+                        st[sp] = def;
                       } else {
-                        shelp.push_back("");
                         logg.msg(ERROR, "non-existing index " + to_string(il) + " found and no default set.");
                         return vempty;
                       }
                     } else {
-                        shelp.push_back(liste[il]);
+                        st[sp] = liste[il];
                     }
-
-                } else if (code.op == UPPER) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(toUpper(sr));
-                } else if (code.op == LOWER) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   shelp.push_back(toLower(sr));
-                } else if (code.op == UGET) {
+                    own[sp++] = 0;
+                    break;
+                case UPPER:
+                   // ASCII letters only, like toUpper
+                   for (char &c : text(sp-1)) {
+                       if ((c >= 'a') && (c <= 'z')) {c -= 32;}
+                   }
+                   break;
+                case LOWER:
+                   for (char &c : text(sp-1)) {
+                       if ((c >= 'A') && (c <= 'Z')) {c += 32;}
+                   }
+                   break;
+                case UGET:
                     if (mode == SINGLE) {
                         logg.msg(ERROR, "Opcode uget not allowed in pexpr.");
                         return vempty;
                     }
-
-                    sl = shelp.back();
-                    il = stoi(sl);
-                    shelp.pop_back();
-                    shelp.push_back(uselist[il-+1]);
-                } else if (code.op == WGET) {
+                    num.assign(st[sp-1]);
+                    il = stoi(num);
+                    st[sp-1] = uselist[il-1];
+                    own[sp-1] = 0;
+                    break;
+                case WGET:
                     if (mode == SINGLE) {
                         logg.msg(ERROR, "Opcode wget not allowed in pexpr.");
                         return vempty;
                     }
-                   sl = shelp.back();
-                   il = stoi(sl);
-                   shelp.pop_back();
-                   shelp.push_back(withlist[il-1]);
-                } else if (code.op == OUT) {
+                    num.assign(st[sp-1]);
+                    il = stoi(num);
+                    st[sp-1] = withlist[il-1];
+                    own[sp-1] = 0;
+                    break;
+                case OUT:
                    if (mode == SINGLE) {
                        logg.msg(ERROR, "Opcode out not allowed in pexpr.");
                        return vempty;
                    }
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   result.push_back(sr);
-                } else if (code.op == DROP) {
-                   shelp.pop_back();
-                } else if (code.op == END) {
-                   break;
-                } else if (code.op == SKIPZ) {
-                   sr = shelp.back();
-                   shelp.pop_back();
-                   if (sr == "0") {j+= code.left;}
+                   result.emplace_back(st[--sp]);
+                   break;
+                case DROP:
+                   --sp;
+                   break;
+                case END:
+                   j = n;
+                   break;
+                case SKIPZ:
+                   if (st[--sp] == ZERO) {j += in.left;}
+                   break;
+                default:
+                   break;
                 }
-                ++j;
             }
 
              i+= incr;
         }
     } catch (exception& e) {
-          logg.msg(FATAL, cstos(e.what()) + ": error when executing plist/pexpr for " + join(ops, " ") + " - ihelp.size = " + to_string(shelp.size()));
+          logg.msg(FATAL, cstos(e.what()) + ": error when executing plist/pexpr for " + join(ops.vec(), " ") + " - ihelp.size = " + to_string(sp));
            if (debug_y) {logg.debug("changed stop execution (plist/pexpr): " + to_string(stopExecution) + "->9");};
           stopExecution = 9;
     }
 
-    if (shelp.size() > 0) {
+    if (sp > 0) {
         if (mode == SINGLE) {
-            for (int i=0; i<(int) shelp.size(); ++i) {
-               result.push_back(shelp[i]);
+            for (int k=0; k<sp; ++k) {
+               result.emplace_back(st[k]);
             }
         } else {
-           logg.msg(WARNALL, "not all op results used for plist - " + to_string(shelp.size()) + " left.");
+           logg.msg(WARNALL, "not all op results used for plist - " + to_string(sp) + " left.");
         }
     }
 
@@ -2364,252 +3153,16 @@ vector<string> Interpreter::bulkExecString(Modes mode, vector<string> &ops, vect
 }
 
 
-int Interpreter::getRight(string op, int pre) {
-    string s = op.substr(pre);
-     if (debug_b) {logg.debug("converting " + s);};
-    return stoi(s);
- }
-
- // get  max. var index value
-int Interpreter::getRowLength(vector<string> v) {
-    int result = 1;
-    string code;
-    for (int i=0;i<(int) v.size(); ++i) {
-        code = v[i];
-        if (code.substr(0,3)== "var") {
-            result = max(result, stoi(code.substr(3)));
-        }
+// the program compiled by the fourth parse completed by the values of its references,
+// or the ops compiled now if they were not known when parsing
+Program& Interpreter::getProgram(Program *program, const List &ops, Program &local) {
+    if ((program != nullptr) && program->isCompiled()) {
+        if (!program->hasHoles()) {return *program;}
+        local = *program;
+        if (local.bind(ops)) {return local;}
     }
-    return result;
- }
-
-vector<Opcode> Interpreter::toOpcode(vector<string> v) {
-    vector<Opcode> result;
-    string code;
-    for (int i=0;i<(int) v.size(); ++i) {
-        code = v[i];
-         if (debug_b) {logg.debug("now processing " + code);};
-        Opcode op;
-        op.sleft = "";
-        op.operands = 2;
-        if (code.substr(0,3) == "row") {
-            op.op = ROW;
-            op.left = getRight(code, 3);
-            op.operands = 0;
-        } else if (code == "and"){
-            op.op = AND;
-            op.left = 0;
-        } else if (code == "or") {
-            op.op = OR;
-            op.left = 0;
-        } else if (code == "?") {
-            op.op = ELVIS;
-            op.left = 0;
-            op.operands = 3;
-         } else if (code == "+") {
-            op.op = PLUS;
-            op.left = 0;
-         } else if (code == "-") {
-            op.op = MINUS;
-            op.left = 0;
-         } else if (code == "*") {
-            op.op = TIMES;
-            op.left = 0;
-         } else if (code == "/") {
-            op.op = DIVIDE;
-            op.left = 0;
-         } else if (code == "&") {
-            op.op = CONCAT;
-            op.left = 0;
-         }  else if (code == "pwr") {
-            op.op = POWER;
-            op.left = 0;
-         } else if (code == "==") {
-            op.op = EQ;
-            op.left = 0;
-         } else if (code == "<>") {
-            op.op = NEQ;
-            op.left = 0;
-         } else if (code == ">=") {
-            op.op = GE;
-            op.left = 0;
-         } else if (code == "<=") {
-            op.op = LE;
-            op.left = 0;
-         } else if (code == ">") {
-            op.op = GT;
-            op.left = 0;
-         } else if (code == "<") {
-            op.op = LT;
-            op.left = 0;
-         } else if (code == "not") {
-            op.op = NOT;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "len") {
-            op.op = LEN;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "abs") {
-            op.op = ABS;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "sqrt") {
-            op.op = SQRT;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "ceil") {
-            op.op = CEIL;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "floor") {
-            op.op = FLOOR;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "round") {
-            op.op = ROUND;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "sin") {
-            op.op = SIN;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "cos") {
-            op.op = COS;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "tan") {
-            op.op = TAN;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "pi") {
-            op.op = VAL;
-            op.sleft = "3.141592653589793";
-            op.operands = 0;
-         } else if (code == "asin") {
-            op.op = ARCSIN;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "acos") {
-            op.op = ARCCOS;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "atan") {
-            op.op = ARCTAN;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "exp") {
-            op.op = EXP;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "log") {
-            op.op = LOG;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "log10") {
-            op.op = LOG10;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "sinh") {
-            op.op = SINH;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "cosh") {
-            op.op = COSH;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "tanh") {
-            op.op = TANH;
-            op.left = 0;
-            op.operands = 1;
-         } else if (code == "out") {
-            op.op = OUT;
-            op.left = 0;
-            op.operands = 1;
-        } else if (code == "%") {
-            op.op = MOD;
-            op.left = 0;
-        } else if ((code == "div") && isExtended) {
-            op.op = DIV;
-            op.left = 0;
-        } else if (code == "min") {
-            op.op = MIN;
-            op.left = 0;
-        } else if (code == "max") {
-            op.op = MAX;
-            op.left = 0;
-        } else if (code == "drop") {
-            op.op = DROP;
-            op.left = 0;
-            op.operands = 1;
-        } else if (code == "end") {
-            op.op = END;
-            op.left = 0;
-            op.operands = 0;
-        }else if (code.substr(0,4) == "skpz") {
-            op.op = SKIPZ;
-            op.left = stoi(code.substr(4));
-            op.operands = 1;
-        } else if (code.substr(0,3)== "val") {
-            op.op = VAL;
-            op.sleft = code.substr(3);
-            op.operands = 0;
-        } else if (code.substr(0,3)== "idx") {
-            op.op = IDX;
-            op.left = 0;
-            op.operands = 0;
-        } else if (code.substr(0,3)== "var") {
-            op.op = VAR;
-            op.operands = 0;
-            op.left = stoi(code.substr(3));
-        } else if ((code == "uget")&& isExtended) {
-            op.op = UGET;
-            op.left = 0;
-            op.operands = 1;
-        } else if ((code == "wget")&& isExtended) {
-            op.op = WGET;
-            op.left = 0;
-            op.operands = 1;
-        } else if (code == "isint") {
-            op.op = ISINT;
-            op.left = 0;
-            op.operands = 1;
-        } else if (code == "isnum") {
-            op.op = ISNUM;
-            op.left = 0;
-            op.operands = 1;
-        } else if (code == "upper") {
-            op.op = UPPER;
-            op.left = 0;
-            op.operands = 1;
-        } else if (code == "lower") {
-            op.op = LOWER;
-            op.left = 0;
-            op.operands = 1;
-        }else if (code.substr(0,3) == "def") {
-            op.op = DEFAULT;
-            op.sleft = code.substr(3);
-            op.operands = 0;
-            if (isInt(op.sleft)) {
-                op.left = stoi(op.sleft);
-                 if (debug_b) {logg.debug("recognized default " + to_string(op.left));};
-            } else {
-                op.op = VAL;
-                op.sleft = code;
-                 if (debug_b) {logg.debug(op.sleft + "regarded as var");};
-            }
-        } else {
-            // assume value and push item on stack
-            op.op = VAL;
-            op.sleft = code;
-            op.operands = 0;
-        }
-        result.push_back(op);
-    }
-
-     if (debug_b) {logg.debug("finished toOpcode.");};
-
-    return result;
+    local.compile(ops.vec(), vector<int>());
+    return local;
 }
 
 int Interpreter::ipower(int b, int e) {
@@ -2648,7 +3201,7 @@ int Interpreter::newStopExecution(int old, StopTypes stype) {
     return result;
 }
 
-vector<string> Interpreter::timeverb(vector<string> &tv) {
+vector<string> Interpreter::timeverb(const vector<string> &tv) {
      vector<string> result;
      string help;
      string help1;
@@ -2689,7 +3242,7 @@ vector<string> Interpreter::timeverb(vector<string> &tv) {
 }
 
 // this function returns its result as the last variable
-void Interpreter::sortRowsLong(int index, int rows, bool isDesc, vector<string> &v, vector<string> &p) {
+void Interpreter::sortRowsLong(int index, int rows, bool isDesc, const List &v, vector<string> &p) {
      map<long long int,vector<string>> m;
      vector<string> w;
      long long int idx = 0;
@@ -2698,7 +3251,7 @@ void Interpreter::sortRowsLong(int index, int rows, bool isDesc, vector<string>
         idx = 0;
         for (int j = 0; j < rows; ++j) {
             w.push_back(v[i+j]);
-            if (j==index-1) {idx = stoll(v[i+j]);}
+            if (j==index-1) {idx = v.getLong(i+j);}
         }
         auto x = m.find(idx);
         if (x==m.end()) {
@@ -2722,7 +3275,7 @@ void Interpreter::sortRowsLong(int index, int rows, bool isDesc, vector<string>
 }
 
 // this function returns its result as the last variable
-void Interpreter::sortRowsString(int index, int rows, bool isDesc, vector<string> &v, vector<string> &p) {
+void Interpreter::sortRowsString(int index, int rows, bool isDesc, const vector<string> &v, vector<string> &p) {
      map<string,vector<string>> m;
      vector<string> w;
      string idx = "";
@@ -2756,7 +3309,7 @@ void Interpreter::sortRowsString(int index, int rows, bool isDesc, vector<string
      }
 }
 
-vector<string> Interpreter::freq(vector<string> &dolist,vector<string> &forlist) {
+vector<string> Interpreter::freq(const List &dolist, const vector<string> &forlist) {
     unordered_map<string, long long int> f;
     vector<string> result;
     string op = forlist[0];
@@ -2764,7 +3317,7 @@ vector<string> Interpreter::freq(vector<string> &dolist,vector<string> &forlist)
         if (op == "unify") {
             for (int i = 0; i < (int) dolist.size(); i+=2) {
                 string key = dolist[i];
-                long long int val = stoll(dolist[i+1]);
+                long long int val = dolist.getLong(i+1);
                  if (debug_x) {logg.debug("processing " + key);};
                 if (f.find(key) != f.end()) {
                    val += f.at(key);
@@ -2786,7 +3339,7 @@ vector<string> Interpreter::freq(vector<string> &dolist,vector<string> &forlist)
             for (int i = 0; i < (int) dolist.size(); i+=2) {
                 string key2 = dolist[i];
                 if (debug_x) {logg.debug("processing " + key2);};
-                long long int val2 = stoll(dolist[i+1]);
+                long long int val2 = dolist.getLong(i+1);
                 if ((val2 > val) || (i==0)){
                     val = val2;
                     keys.clear();
@@ -2806,7 +3359,7 @@ vector<string> Interpreter::freq(vector<string> &dolist,vector<string> &forlist)
             for (int i = 0; i < (int) dolist.size(); i+=2) {
                 string key2 = dolist[i];
                  if (debug_x) {logg.debug("processing " + key2);};
-                long long int val2 = stoll(dolist[i+1]);
+                long long int val2 = dolist.getLong(i+1);
                 if ((val2 < val) || (i==0)) {
                     val = val2;
                     keys.clear();
@@ -2835,12 +3388,10 @@ int Interpreter::vmemsize(vector<string> v) {
     return sizeof(v) + sizeof(string) * v.capacity();
 }
 
-int Interpreter::mmemsize(unordered_map<int, vector<string>> slists) {
+int Interpreter::mmemsize(vector<Slist> &slists) {
     int ms = 0;
-    auto iter = slists.begin();
-    while (iter != slists.end()) {
-        ms +=  sizeof(iter->first) + sizeof(iter->second) * iter->second.capacity();
-        ++iter;
+    for (int i = 0; i < (int) slists.size(); ++i) {
+        ms +=  sizeof(slists[i]) + sizeof(string) * slists[i].list.size();
     }
     return ms;
 }
@@ -18,6 +18,9 @@ This file is part of the SOPL Interpreter.
 */
 
 #include "Item.h"
+#include "Program.h"
+#include "Rowplan.h"
+#include "Combineplan.h"
 #include "globals.h"
 
 using namespace std;
@@ -27,6 +30,17 @@ Item::Item(string pname)
 {
     isError = false;
     verbType = 0;
+    verbId = V_NONE;
+    paraIndex = -1;
+    stype = "";
+    verbMode = 0;
+    echoIn = false;
+    echoOut = false;
+    modInt = false;
+    modFloat = false;
+    refSlot = R_NONE;
+    refKind = RK_WHOLE;
+    refSentence = -1;
     // set name and typ
     entry = pname;
     name = pname;
@@ -34,6 +48,9 @@ Item::Item(string pname)
     condLevel = 0;
     getSize = false;
     forget = false;
+    memo = false;
+    chunk = 0;
+    reduceIndex = -1;
     string refname = pname;
     int len = refname.size();
     refFrom = 0;
@@ -98,6 +115,7 @@ Item::Item(string pname)
             } else {
                 verbType = 3;
             }
+            verbId = (verbType == 3) ? V_PARAGRAPH : toVerbId(name);
         }
     } catch(exception &e) {
         string s = e.what();
@@ -124,6 +142,7 @@ Item::Item(string pname)
                     log.msg(FATAL, "ref modifier " + parts[i] + " not recognized.");
                 }
             }
+            setRefSlot();
         }
     } catch(exception &e) {
         string s = e.what();
@@ -135,6 +154,28 @@ Item::Item(string pname)
             for (int i=0;i<(int)parts.size(); ++i) {
                 string part = parts[i];
                 if (part == "forget") {forget = true;}
+                if (part == "memo") {memo = true;}
+                if (part == "int") {
+                    stype = "long";
+                    modInt = true;
+                } else if (part == "float") {
+                    stype = "float";
+                    modFloat = true;
+                } else if (part == "perRow") {
+                    verbMode = 1;
+                } else if (part == "combine") {
+                    verbMode = 2;
+                } else if (part == "parallel") {
+                    verbMode = 3;
+                } else if ((part.substr(0, 5) == "chunk") && isInt(part.substr(5)) && (stoi(part.substr(5)) > 0)) {
+                    chunk = stoi(part.substr(5));
+                    continue;
+                } else if ((part.substr(0, 6) == "reduce") && (part.size() > 6)) {
+                    reduce = part.substr(6);
+                    continue;
+                }
+                if ((part == "echoIn") || (part == "echo")) {echoIn = true;}
+                if ((part == "echoOut") || (part == "echo")) {echoOut = true;}
                 if (!contains(part, vmods) && ((part[0]!= '>') || !isExtended)) {
                     isError = true;
                     log.msg(FATAL, "verb modifier " + parts[i] + " not recognized.");
@@ -196,6 +237,7 @@ Item::~Item()
             }
         }
         if (getSize) {s += "+||";}
+        if (paraIndex >= 0) {s += "@" + to_string(paraIndex);}
         if (typ == 'r') { s += "[" + to_string(refFrom) + ".." + to_string(refTo) + "]";}
         return s;
     }
@@ -256,10 +298,219 @@ Item::~Item()
         return forget;
     }
 
+    bool Item::hasMemo() {
+        return memo;
+    }
+
+    // modifier memo is ignored, e.g. for an impure paragraph
+    void Item::clearMemo() {
+        memo = false;
+    }
+
+    // number of elements per chunk of modifier parallel (modifier chunkN), 0 = one chunk per thread
+    int Item::getChunk() {
+        return chunk;
+    }
+
+    // name of the paragraph which combines the results of the chunks (modifier reduceName), empty if they are joined
+    string Item::getReduce() {
+        return reduce;
+    }
+
+    int Item::getReduceIndex() {
+        return reduceIndex;
+    }
+
+    void Item::setReduceIndex(int index) {
+        reduceIndex = index;
+    }
+
+    // modifier parallel is ignored for a verb which is no paragraph
+    void Item::clearParallel() {
+        if (verbMode == 3) {verbMode = 0;}
+    }
+
     int Item::getVerbType() {
         return verbType;
     }
 
+    Verbs Item::getVerbId() {
+        return verbId;
+    }
+
+    // map the name of a standard or other verb to its id
+    Verbs Item::toVerbId(string vname) {
+        Verbs result = V_NONE;
+        if (vname == "cond") {
+            result = V_COND;
+        } else if (vname == "del") {
+            result = V_DEL;
+        } else if (vname == "expand") {
+            result = V_EXPAND;
+        } else if (vname == "file") {
+            result = V_FILE;
+        } else if (vname == "find") {
+            result = V_FIND;
+        } else if (vname == "freq") {
+            result = V_FREQ;
+        } else if (vname == "get") {
+            result = V_GET;
+        } else if (vname == "id") {
+            result = V_ID;
+        } else if (vname == "include") {
+            result = V_INCLUDE;
+        } else if (vname == "input") {
+            result = V_INPUT;
+        } else if (vname == "ins") {
+            result = V_INS;
+        } else if (vname == "join") {
+            result = V_JOIN;
+        } else if (vname == "mask") {
+            result = V_MASK;
+        } else if (vname == "minus") {
+            result = V_MINUS;
+        } else if (vname == "output") {
+            result = V_OUTPUT;
+        } else if (vname == "pexpr") {
+            result = V_PEXPR;
+        } else if (vname == "print") {
+            result = V_PRINT;
+        } else if (vname == "range") {
+            result = V_RANGE;
+        } else if (vname == "readLines") {
+            result = V_READLINES;
+        } else if (vname == "reverse") {
+            result = V_REVERSE;
+        } else if (vname == "returnValue") {
+            result = V_RETURNVALUE;
+        } else if (vname == "set") {
+            result = V_SET;
+        } else if (vname == "sort") {
+            result = V_SORT;
+        } else if (vname == "split") {
+            result = V_SPLIT;
+        } else if (vname == "time") {
+            result = V_TIME;
+        } else if (vname == "unique") {
+            result = V_UNIQUE;
+        } else if (vname == "writeLines") {
+            result = V_WRITELINES;
+        } else if (vname == "plist") {
+            result = V_PLIST;
+        } else if (vname == "between") {
+            result = V_BETWEEN;
+        } else if (vname == "nop") {
+            result = V_NOP;
+        } else if (vname == "stop") {
+            result = V_STOP;
+        }
+        return result;
+    }
+
+    int Item::getParaIndex() {
+        return paraIndex;
+    }
+
+    void Item::setParaIndex(int index) {
+        paraIndex = index;
+    }
+
+    string Item::getStype() {
+        return stype;
+    }
+
+    int Item::getVerbMode() {
+        return verbMode;
+    }
+
+    bool Item::hasEchoIn() {
+        return echoIn;
+    }
+
+    bool Item::hasEchoOut() {
+        return echoOut;
+    }
+
+    bool Item::hasModInt() {
+        return modInt;
+    }
+
+    bool Item::hasModFloat() {
+        return modFloat;
+    }
+
+    // classify a reference once, so that the interpreter need not compare names
+    void Item::setRefSlot() {
+        if (name == "this") {
+            refSlot = R_THIS;
+        } else if (name == "params") {
+            refSlot = R_PARAMS;
+        } else if (name == "forparams") {
+            refSlot = R_FORPARAMS;
+        } else if (name == "useparams") {
+            refSlot = R_USEPARAMS;
+        } else if (name == "withparams") {
+            refSlot = R_WITHPARAMS;
+        } else if (name == "args") {
+            refSlot = R_ARGS;
+        } else {
+            refSlot = R_SENTENCE;
+        }
+
+        if (getSize) {
+            refKind = RK_SIZE;
+        } else if ((refFrom == 0) && (refTo == -1)) {
+            refKind = RK_WHOLE;
+        } else if (refFrom == refTo) {
+            refKind = RK_INDEX;
+        } else {
+            refKind = RK_RANGE;
+        }
+    }
+
+    RefSlots Item::getRefSlot() {
+        return refSlot;
+    }
+
+    RefKinds Item::getRefKind() {
+        return refKind;
+    }
+
+    int Item::getRefSentence() {
+        return refSentence;
+    }
+
+    void Item::setRefSentence(int sc) {
+        refSentence = sc;
+    }
+
+    // nullptr if the ops are compiled at run time
+    Program* Item::getProgram() {
+        return program.get();
+    }
+
+    void Item::setProgram(shared_ptr<Program> p) {
+        program = p;
+    }
+
+    // nullptr if the pattern is parsed at run time
+    Rowplan* Item::getRowplan() {
+        return rowplan.get();
+    }
+
+    void Item::setRowplan(shared_ptr<Rowplan> p) {
+        rowplan = p;
+    }
+
+    // nullptr if the pattern is parsed at run time
+    Combineplan* Item::getCombineplan() {
+        return combineplan.get();
+    }
+
+    void Item::setCombineplan(shared_ptr<Combineplan> p) {
+        combineplan = p;
+    }
+
     int Item::getRefFrom() {
         return refFrom;
     }
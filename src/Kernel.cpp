@@ -0,0 +1,446 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "Kernel.h"
+#include <algorithm>
+#include <math.h>
+
+using namespace std;
+
+Kernel::Kernel(const Program &p, bool exact) : prog(p), exactMath(exact)
+{
+    //ctor
+}
+
+Kernel::~Kernel()
+{
+    //dtor
+}
+
+// executes the rows from..to-1, values of the outputs are added to result and values
+// lv are the values of liste (if all known), without cache the parsed values are not stored in liste (threads)
+bool Kernel::runLong(const List &liste, const long long int *lv, int len, int incr, int from, int to, bool cache,
+                     bool hasdefault, long long int def, vector<string> &result, vector<long long int> &values) {
+    if (incr <= 0) {return false;}
+    int nouts = max(prog.outs, 0);
+    size_t start = result.size();
+    // stack of columns, column sp-1 is the top (two spare columns below the bottom)
+    vector<long long int> stack((prog.maxDepth + 3) * BLOCK);
+    long long int *base = stack.data() + 2 * BLOCK;
+    vector<long long int> outs((nouts + 1) * BLOCK);
+
+    try {
+        for (int r0 = from; r0 < to; r0 += BLOCK) {
+            // rows of the block, the remaining lanes of a short block repeat the last row
+            int m = min(BLOCK, to - r0);
+            int sp = 0;
+            int o = 0;
+            for (const Instr &in : prog.instrs) {
+                long long int * __restrict a = base + (sp - 2) * BLOCK;
+                long long int * __restrict b = base + (sp - 1) * BLOCK;
+                long long int * __restrict c = base + sp * BLOCK;
+                switch (in.op) {
+                case VAL:
+                    for (int k = 0; k < BLOCK; ++k) {c[k] = in.lvalue;}
+                    ++sp;
+                    break;
+                case VAR:
+                    for (int k = 0; k < m; ++k) {
+                        int il = (r0 + k) * incr + in.left - 1;
+                        if ((il >= 0) && (il < len)) {
+                            c[k] = (lv != nullptr) ? lv[il] : (cache ? liste.getLong(il) : liste.peekLong(il));
+                        } else if (hasdefault) {
+                            c[k] = def;
+                        } else {
+                            // the error is reported by the row by row execution
+                            result.resize(start);
+                            values.resize(start);
+                            return false;
+                        }
+                    }
+                    fill(c + m, c + BLOCK, c[m - 1]);
+                    ++sp;
+                    break;
+                case IDX:
+                    for (int k = 0; k < m; ++k) {c[k] = (r0 + k) * incr + 1;}
+                    fill(c + m, c + BLOCK, c[m - 1]);
+                    ++sp;
+                    break;
+                case NOT:
+                    for (int k = 0; k < BLOCK; ++k) {b[k] = (b[k] == 0) ? 1 : 0;}
+                    break;
+                case ABS:
+                    for (int k = 0; k < BLOCK; ++k) {b[k] = (b[k] >= 0) ? b[k] : -b[k];}
+                    break;
+                case AND:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = ((b[k] > 0) && (a[k] > 0)) ? 1 : 0;}
+                    --sp;
+                    break;
+                case OR:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = ((b[k] > 0) || (a[k] > 0)) ? 1 : 0;}
+                    --sp;
+                    break;
+                case PLUS:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] += b[k];}
+                    --sp;
+                    break;
+                case MINUS:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] -= b[k];}
+                    --sp;
+                    break;
+                case TIMES:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] *= b[k];}
+                    --sp;
+                    break;
+                case DIVIDE:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] /= b[k];}
+                    --sp;
+                    break;
+                case MOD:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] %= b[k];}
+                    --sp;
+                    break;
+                case MAX:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] > b[k]) ? a[k] : b[k];}
+                    --sp;
+                    break;
+                case MIN:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] < b[k]) ? a[k] : b[k];}
+                    --sp;
+                    break;
+                case DIV:
+                    for (int k = 0; k < BLOCK; ++k) {
+                        long long int r = a[k] % b[k];
+                        a[k] = (a[k] - r) / b[k];
+                        b[k] = r;
+                    }
+                    break;
+                case POWER:
+                    // the exponent is a loop count, so the repeated lanes are not computed
+                    for (int k = 0; k < m; ++k) {
+                        long long int p = 1;
+                        for (int e = 1; e <= b[k]; ++e) {p *= a[k];}
+                        a[k] = p;
+                    }
+                    fill(a + m, a + BLOCK, a[m - 1]);
+                    --sp;
+                    break;
+                case EQ:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] == b[k]) ? 1 : 0;}
+                    --sp;
+                    break;
+                case NEQ:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] != b[k]) ? 1 : 0;}
+                    --sp;
+                    break;
+                case GE:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] >= b[k]) ? 1 : 0;}
+                    --sp;
+                    break;
+                case LE:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] <= b[k]) ? 1 : 0;}
+                    --sp;
+                    break;
+                case GT:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] > b[k]) ? 1 : 0;}
+                    --sp;
+                    break;
+                case LT:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] < b[k]) ? 1 : 0;}
+                    --sp;
+                    break;
+                case ELVIS: {
+                    // condition, value if true, value if false
+                    long long int * __restrict d = a - BLOCK;
+                    for (int k = 0; k < BLOCK; ++k) {d[k] = (d[k] > 0) ? a[k] : b[k];}
+                    sp -= 2;
+                    break;
+                }
+                case OUT:
+                    copy(b, b + BLOCK, outs.data() + o * BLOCK);
+                    ++o;
+                    --sp;
+                    break;
+                case DROP:
+                    --sp;
+                    break;
+                default:
+                    break;
+                }
+            }
+            // outputs in the order of the rows
+            for (int k = 0; k < m; ++k) {
+                for (int q = 0; q < nouts; ++q) {
+                    long long int v = outs[q * BLOCK + k];
+                    result.push_back(to_string(v));
+                    values.push_back(v);
+                }
+            }
+        }
+    } catch (exception &e) {
+        // a value is not numeric, the error is reported by the row by row execution
+        result.resize(start);
+        values.resize(start);
+        return false;
+    }
+    return true;
+}
+
+// executes the rows from..to-1
+bool Kernel::runFloat(const List &liste, int len, int incr, int from, int to, bool cache, bool hasdefault, double def,
+                      vector<string> &result) {
+    if (incr <= 0) {return false;}
+    int nouts = max(prog.outs, 0);
+    size_t start = result.size();
+    // stack of columns, column sp-1 is the top (two spare columns below the bottom)
+    vector<double> stack((prog.maxDepth + 3) * BLOCK);
+    double *base = stack.data() + 2 * BLOCK;
+    vector<double> outs((nouts + 1) * BLOCK);
+
+    try {
+        for (int r0 = from; r0 < to; r0 += BLOCK) {
+            // rows of the block, the remaining lanes of a short block repeat the last row
+            int m = min(BLOCK, to - r0);
+            int sp = 0;
+            int o = 0;
+            for (const Instr &in : prog.instrs) {
+                double * __restrict a = base + (sp - 2) * BLOCK;
+                double * __restrict b = base + (sp - 1) * BLOCK;
+                double * __restrict c = base + sp * BLOCK;
+                switch (in.op) {
+                case VAL:
+                    for (int k = 0; k < BLOCK; ++k) {c[k] = in.dvalue;}
+                    ++sp;
+                    break;
+                case VAR:
+                    for (int k = 0; k < m; ++k) {
+                        int il = (r0 + k) * incr + in.left - 1;
+                        if ((il >= 0) && (il < len)) {
+                            c[k] = cache ? liste.getDouble(il) : liste.peekDouble(il);
+                        } else if (hasdefault) {
+                            c[k] = def;
+                        } else {
+                            // the error is reported by the row by row execution
+                            result.resize(start);
+                            return false;
+                        }
+                    }
+                    fill(c + m, c + BLOCK, c[m - 1]);
+                    ++sp;
+                    break;
+                case IDX:
+                    for (int k = 0; k < m; ++k) {c[k] = (r0 + k) * incr + 1;}
+                    fill(c + m, c + BLOCK, c[m - 1]);
+                    ++sp;
+                    break;
+                case NOT:
+                    for (int k = 0; k < BLOCK; ++k) {b[k] = (b[k] == 0) ? 1 : 0;}
+                    break;
+                case ABS:
+                    for (int k = 0; k < BLOCK; ++k) {b[k] = (b[k] >= 0) ? b[k] : -b[k];}
+                    break;
+                case CEIL:
+                    for (int k = 0; k < BLOCK; ++k) {b[k] = ceil(b[k]);}
+                    break;
+                case FLOOR:
+                    for (int k = 0; k < BLOCK; ++k) {b[k] = floor(b[k]);}
+                    break;
+                case ROUND:
+                    for (int k = 0; k < BLOCK; ++k) {b[k] = round(b[k]);}
+                    break;
+                case SQRT:
+                    for (int k = 0; k < BLOCK; ++k) {b[k] = sqrt(b[k]);}
+                    break;
+                case SIN:
+                    if (exactMath) {
+                        for (int k = 0; k < BLOCK; ++k) {b[k] = sin(b[k]);}
+                    } else {
+                        vm.vsin(b);
+                    }
+                    break;
+                case COS:
+                    if (exactMath) {
+                        for (int k = 0; k < BLOCK; ++k) {b[k] = cos(b[k]);}
+                    } else {
+                        vm.vcos(b);
+                    }
+                    break;
+                case TAN:
+                    if (exactMath) {
+                        for (int k = 0; k < BLOCK; ++k) {b[k] = tan(b[k]);}
+                    } else {
+                        vm.vtan(b);
+                    }
+                    break;
+                case ARCSIN:
+                    for (int k = 0; k < BLOCK; ++k) {b[k] = asin(b[k]);}
+                    break;
+                case ARCCOS:
+                    for (int k = 0; k < BLOCK; ++k) {b[k] = acos(b[k]);}
+                    break;
+                case ARCTAN:
+                    for (int k = 0; k < BLOCK; ++k) {b[k] = atan(b[k]);}
+                    break;
+                case EXP:
+                    if (exactMath) {
+                        for (int k = 0; k < BLOCK; ++k) {b[k] = exp(b[k]);}
+                    } else {
+                        vm.vexp(b);
+                    }
+                    break;
+                case LOG:
+                    if (exactMath) {
+                        for (int k = 0; k < BLOCK; ++k) {b[k] = log(b[k]);}
+                    } else {
+                        vm.vlog(b);
+                    }
+                    break;
+                case LOG10:
+                    if (exactMath) {
+                        for (int k = 0; k < BLOCK; ++k) {b[k] = log10(b[k]);}
+                    } else {
+                        vm.vlog10(b);
+                    }
+                    break;
+                case SINH:
+                    if (exactMath) {
+                        for (int k = 0; k < BLOCK; ++k) {b[k] = sinh(b[k]);}
+                    } else {
+                        vm.vsinh(b);
+                    }
+                    break;
+                case COSH:
+                    if (exactMath) {
+                        for (int k = 0; k < BLOCK; ++k) {b[k] = cosh(b[k]);}
+                    } else {
+                        vm.vcosh(b);
+                    }
+                    break;
+                case TANH:
+                    if (exactMath) {
+                        for (int k = 0; k < BLOCK; ++k) {b[k] = tanh(b[k]);}
+                    } else {
+                        vm.vtanh(b);
+                    }
+                    break;
+                case AND:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = ((b[k] > 0) && (a[k] > 0)) ? 1 : 0;}
+                    --sp;
+                    break;
+                case OR:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = ((b[k] > 0) || (a[k] > 0)) ? 1 : 0;}
+                    --sp;
+                    break;
+                case PLUS:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] += b[k];}
+                    --sp;
+                    break;
+                case MINUS:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] -= b[k];}
+                    --sp;
+                    break;
+                case TIMES:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] *= b[k];}
+                    --sp;
+                    break;
+                case DIVIDE:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] /= b[k];}
+                    --sp;
+                    break;
+                case MOD:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (int) round(a[k]) % (int) round(b[k]);}
+                    --sp;
+                    break;
+                case MAX:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] > b[k]) ? a[k] : b[k];}
+                    --sp;
+                    break;
+                case MIN:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] < b[k]) ? a[k] : b[k];}
+                    --sp;
+                    break;
+                case DIV:
+                    for (int k = 0; k < BLOCK; ++k) {
+                        double r = (int) round(a[k]) % (int) round(b[k]);
+                        a[k] = (a[k] - r) / b[k];
+                        b[k] = r;
+                    }
+                    break;
+                case POWER:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = pow(a[k], b[k]);}
+                    --sp;
+                    break;
+                case EQ:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] == b[k]) ? 1 : 0;}
+                    --sp;
+                    break;
+                case NEQ:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] != b[k]) ? 1 : 0;}
+                    --sp;
+                    break;
+                case GE:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] >= b[k]) ? 1 : 0;}
+                    --sp;
+                    break;
+                case LE:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] <= b[k]) ? 1 : 0;}
+                    --sp;
+                    break;
+                case GT:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] > b[k]) ? 1 : 0;}
+                    --sp;
+                    break;
+                case LT:
+                    for (int k = 0; k < BLOCK; ++k) {a[k] = (a[k] < b[k]) ? 1 : 0;}
+                    --sp;
+                    break;
+                case ELVIS: {
+                    // condition, value if true, value if false
+                    double * __restrict d = a - BLOCK;
+                    for (int k = 0; k < BLOCK; ++k) {d[k] = (d[k] > 0) ? a[k] : b[k];}
+                    sp -= 2;
+                    break;
+                }
+                case OUT:
+                    copy(b, b + BLOCK, outs.data() + o * BLOCK);
+                    ++o;
+                    --sp;
+                    break;
+                case DROP:
+                    --sp;
+                    break;
+                default:
+                    break;
+                }
+            }
+            // outputs in the order of the rows
+            for (int k = 0; k < m; ++k) {
+                for (int q = 0; q < nouts; ++q) {
+                    result.push_back(to_string(outs[q * BLOCK + k]));
+                }
+            }
+        }
+    } catch (exception &e) {
+        // a value is not numeric, the error is reported by the row by row execution
+        result.resize(start);
+        return false;
+    }
+    return true;
+}
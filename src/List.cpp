@@ -0,0 +1,243 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "List.h"
+#include <stdexcept>
+
+using namespace std;
+
+const vector<string> List::none;
+thread_local bool List::concurrent = false;
+
+List::List()
+{
+    //ctor, an empty list needs no storage
+    offset = 0;
+    length = 0;
+    sliced = false;
+}
+
+List::List(const vector<string> &v)
+{
+    offset = 0;
+    length = 0;
+    sliced = false;
+    if (v.size() > 0) {
+        data = make_shared<ListContent>();
+        data->v = v;
+    }
+}
+
+List::List(vector<string> &&v)
+{
+    offset = 0;
+    length = 0;
+    sliced = false;
+    if (v.size() > 0) {
+        data = make_shared<ListContent>();
+        data->v = move(v);
+    }
+}
+
+// elements together with their values, e.g. the results of plist-int
+List::List(vector<string> &&v, vector<long long int> &&longs)
+{
+    offset = 0;
+    length = 0;
+    sliced = false;
+    if (v.size() > 0) {
+        data = make_shared<ListContent>();
+        data->v = move(v);
+        data->longs = move(longs);
+        data->known.assign(data->v.size(), 1);
+    }
+}
+
+List::~List()
+{
+    //dtor
+}
+
+const string& List::at(size_t index) const {
+    if (index >= size()) {throw out_of_range("List::at");}
+    return data->v[offset + index];
+}
+
+const string& List::back() const {
+    return data->v[offset + size() - 1];
+}
+
+vector<string>::const_iterator List::begin() const {
+    if (!data) {return none.begin();}
+    return data->v.cbegin() + offset;
+}
+
+vector<string>::const_iterator List::end() const {
+    if (!data) {return none.end();}
+    return data->v.cbegin() + offset + size();
+}
+
+// view on the elements [from, to) sharing the content, from < to <= size() is expected
+List List::slice(size_t from, size_t to) const {
+    List result;
+    if ((from < to) && (to <= size())) {
+        result.data = data;
+        result.offset = offset + from;
+        result.length = to - from;
+        result.sliced = true;
+    }
+    return result;
+}
+
+bool List::isSlice() const {
+    return sliced;
+}
+
+long long int List::parseLong(size_t index) const {
+    if (index >= size()) {throw out_of_range("List::getLong");}
+    if (concurrent) {return stoll(data->v[offset + index]);}
+    ListContent &c = *data;
+    size_t k = offset + index;
+    if (c.known.size() == 0) {c.known.assign(c.v.size(), 0);}
+    if ((c.known[k] & 1) == 0) {
+        if (c.longs.size() == 0) {c.longs.resize(c.v.size());}
+        c.longs[k] = stoll(c.v[k]);
+        c.known[k] |= 1;
+    }
+    return c.longs[k];
+}
+
+// the values of all elements, if they are all known (nullptr otherwise)
+const long long int* List::longValues() const {
+    size_t len = size();
+    if ((len == 0) || (data->known.size() < offset + len)) {return nullptr;}
+    for (size_t k = offset; k < offset + len; ++k) {
+        if ((data->known[k] & 1) == 0) {return nullptr;}
+    }
+    return data->longs.data() + offset;
+}
+
+double List::parseDouble(size_t index) const {
+    if (index >= size()) {throw out_of_range("List::getDouble");}
+    if (concurrent) {return stod(data->v[offset + index]);}
+    ListContent &c = *data;
+    size_t k = offset + index;
+    if (c.known.size() == 0) {c.known.assign(c.v.size(), 0);}
+    if ((c.known[k] & 2) == 0) {
+        if (c.doubles.size() == 0) {c.doubles.resize(c.v.size());}
+        c.doubles[k] = stod(c.v[k]);
+        c.known[k] |= 2;
+    }
+    return c.doubles[k];
+}
+
+// replace the view by a copy of its elements (and of the values known so far)
+void List::materialize() const {
+    shared_ptr<ListContent> c = make_shared<ListContent>();
+    size_t from = offset;
+    size_t to = offset + size();
+    c->v.assign(data->v.begin() + from, data->v.begin() + to);
+    if (data->known.size() > 0) {
+        c->known.assign(data->known.begin() + from, data->known.begin() + to);
+        if (data->longs.size() > 0) {c->longs.assign(data->longs.begin() + from, data->longs.begin() + to);}
+        if (data->doubles.size() > 0) {c->doubles.assign(data->doubles.begin() + from, data->doubles.begin() + to);}
+    }
+    data = c;
+    offset = 0;
+    length = 0;
+    sliced = false;
+}
+
+// make the content unshared before changing it
+void List::own() {
+    if (!data) {
+        data = make_shared<ListContent>();
+    } else if (sliced || (data.use_count() > 1)) {
+        materialize();
+    }
+}
+
+// the caller may change any element, so the known values are dropped
+vector<string>& List::edit() {
+    own();
+    data->longs.clear();
+    data->doubles.clear();
+    data->known.clear();
+    return data->v;
+}
+
+// add an element, the values known for the other elements are kept
+void List::push(const string &s) {
+    own();
+    data->v.push_back(s);
+    if (data->known.size() > 0) {data->known.push_back(0);}
+    if (data->longs.size() > 0) {data->longs.push_back(0);}
+    if (data->doubles.size() > 0) {data->doubles.push_back(0);}
+}
+
+// add the elements of another list together with their known values
+void List::append(const List &other) {
+    size_t n = other.size();
+    if (n == 0) {return;}
+    if (size() == 0) {
+        *this = other;
+        return;
+    }
+    own();
+    ListContent &c = *data;
+    ListContent &o = *other.data;
+    size_t from = other.offset;
+    size_t to = other.offset + n;
+    size_t old = c.v.size();
+    c.v.insert(c.v.end(), o.v.begin() + from, o.v.begin() + to);
+    if ((c.known.size() == 0) && (o.known.size() == 0)) {return;}
+    c.known.resize(old, 0);
+    if (o.known.size() > 0) {
+        c.known.insert(c.known.end(), o.known.begin() + from, o.known.begin() + to);
+    } else {
+        c.known.resize(c.v.size(), 0);
+    }
+    if ((c.longs.size() > 0) || (o.longs.size() > 0)) {
+        c.longs.resize(old);
+        if (o.longs.size() > 0) {
+            c.longs.insert(c.longs.end(), o.longs.begin() + from, o.longs.begin() + to);
+        } else {
+            c.longs.resize(c.v.size());
+        }
+    }
+    if ((c.doubles.size() > 0) || (o.doubles.size() > 0)) {
+        c.doubles.resize(old);
+        if (o.doubles.size() > 0) {
+            c.doubles.insert(c.doubles.end(), o.doubles.begin() + from, o.doubles.begin() + to);
+        } else {
+            c.doubles.resize(c.v.size());
+        }
+    }
+}
+
+void List::clear() {
+    data.reset();
+    offset = 0;
+    length = 0;
+    sliced = false;
+}
+
+bool List::isShared() const {
+    return data.use_count() > 1;
+}
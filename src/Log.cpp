@@ -49,6 +49,10 @@ void Log::setUseConsole(bool uc) {
 }
 void Log::msg(Level lv, string text) {
     if (lv>=level) {
+        if (capture != nullptr) {
+            capture->push_back(make_pair(lv, text));
+            return;
+        }
         if (useconsole) {cerr << datum() << " " << levelString(lv) << text << endl;}
         fstream fs;
         fs.open(filename,ios::app);
@@ -22,6 +22,12 @@ This file is part of the SOPL Interpreter.
 Opcode::Opcode()
 {
     //ctor
+    left = 0;
+    pos = -1;
+    lvalue = 0;
+    dvalue = 0.0;
+    hasLong = false;
+    hasDouble = false;
 }
 
 Opcode::~Opcode()
@@ -22,6 +22,8 @@ This file is part of the SOPL Interpreter.
 Paragraph::Paragraph()
 {
     //ctor
+    callerThis = true;
+    pure = false;
 }
 
 Paragraph::~Paragraph()
@@ -37,10 +39,14 @@ Paragraph::~Paragraph()
     sentences.push_back(sentence);
  };
 
- Sentence Paragraph::getSentence(int index) {
+ Sentence& Paragraph::getSentence(int index) {
      return sentences[index];
  };
 
+void Paragraph::setSentence(int index, Sentence sentence) {
+    sentences[index] = sentence;
+}
+
 int Paragraph::getLength() {
     return sentences.size();
 };
@@ -57,6 +63,22 @@ bool Paragraph::isHeader() {
    return header;
 }
 
+void Paragraph::setReadsThis(bool b) {
+    callerThis = b;
+}
+
+bool Paragraph::readsThis() {
+    return callerThis;
+}
+
+void Paragraph::setPure(bool b) {
+    pure = b;
+}
+
+bool Paragraph::isPure() {
+    return pure;
+}
+
 void Paragraph::setSaved(int index) {
     Sentence s = sentences[index];
     s.setSaved();
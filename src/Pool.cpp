@@ -0,0 +1,123 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "Pool.h"
+
+using namespace std;
+
+Pool::Pool()
+{
+    //ctor
+    queued = 0;
+    idle = 0;
+    quit = false;
+}
+
+Pool::~Pool()
+{
+    //dtor
+    setThreads(1);
+}
+
+// n threads including the calling one
+void Pool::setThreads(int n) {
+    {
+        unique_lock<mutex> lock(m);
+        quit = true;
+    }
+    changed.notify_all();
+    for (thread &t : workers) {t.join();}
+    workers.clear();
+    quit = false;
+    for (int i = 1; i < n; ++i) {
+        workers.push_back(thread(&Pool::work, this));
+    }
+}
+
+int Pool::getThreads() {
+    return workers.size() + 1;
+}
+
+// true if a task started now would be taken by a thread at once
+bool Pool::hasIdle() {
+    unique_lock<mutex> lock(m);
+    return idle > queued;
+}
+
+void Pool::run(int tasks, const function<void(int)> &task) {
+    if (workers.empty() || (tasks <= 1)) {
+        for (int i = 0; i < tasks; ++i) {task(i);}
+        return;
+    }
+    Job job = {&task, tasks, 0, tasks};
+    unique_lock<mutex> lock(m);
+    jobs.push_back(&job);
+    queued += tasks;
+    changed.notify_all();
+    while (job.open > 0) {
+        // the own tasks first, then the tasks of other jobs
+        Job *current = &job;
+        if (job.next >= job.total) {
+            if (jobs.empty()) {
+                ++idle;
+                changed.wait(lock);
+                --idle;
+                continue;
+            }
+            current = jobs.front();
+        }
+        int index = take(*current);
+        lock.unlock();
+        (*current->task)(index);
+        lock.lock();
+        if (--current->open == 0) {changed.notify_all();}
+    }
+}
+
+// the next task of a job (with the lock held), a job is removed from the queue with its last task
+int Pool::take(Job &job) {
+    int index = job.next++;
+    --queued;
+    if (job.next >= job.total) {
+        for (auto it = jobs.begin(); it != jobs.end(); ++it) {
+            if (*it == &job) {
+                jobs.erase(it);
+                break;
+            }
+        }
+    }
+    return index;
+}
+
+void Pool::work() {
+    unique_lock<mutex> lock(m);
+    while (true) {
+        ++idle;
+        changed.wait(lock, [this] {return quit || !jobs.empty();});
+        --idle;
+        if (quit) {return;}
+        Job *job = jobs.front();
+        int index = take(*job);
+        lock.unlock();
+        (*job->task)(index);
+        lock.lock();
+        if (--job->open == 0) {changed.notify_all();}
+    }
+}
@@ -0,0 +1,689 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "Program.h"
+#include "globals.h"
+#include <climits>
+
+using namespace std;
+
+Program::Program()
+{
+    //ctor
+    prefixLength = 0;
+    hasPrefix = false;
+    incr = 1;
+    hasdefault = false;
+    def = 0;
+    sdef = "";
+    maxvar = 1;
+    stackSize = 0;
+    backJump = false;
+    outs = 0;
+    longKernel = false;
+    floatKernel = false;
+    depth = 0;
+    maxDepth = 0;
+    compiled = false;
+    folded = false;
+    fulfilled = false;
+    fused = false;
+    fusion.type = 'l';
+    fusion.op = PLUS;
+    for (int k = 0; k < 2; ++k) {
+        fusion.ref[k] = -1;
+        fusion.lvalue[k] = 0;
+        fusion.dvalue[k] = 0;
+    }
+    dispatched = false;
+    dispatch.other = 1;
+    dispatch.length = 0;
+}
+
+Program::~Program()
+{
+    //dtor
+}
+
+// pholes are the positions of ops whose values are only known at run time (sorted)
+void Program::compile(const vector<string> &ops, const vector<int> &pholes) {
+    codes.clear();
+    holes = pholes;
+    prefixLength = 0;
+    hasPrefix = false;
+    incr = 1;
+    hasdefault = false;
+    def = 0;
+    sdef = "";
+    maxvar = 1;
+    size_t h = 0;
+    for (int i = 0; i < (int) ops.size(); ++i) {
+        if ((h < holes.size()) && (holes[h] == i)) {
+            // placeholder, replaced by bind
+            Opcode op;
+            op.op = VAL;
+            op.left = 0;
+            op.operands = 0;
+            codes.push_back(op);
+            ++h;
+            continue;
+        }
+        codes.push_back(toOpcode(ops[i], i));
+        // get  max. var index value
+        if (ops[i].substr(0,3)== "var") {
+            maxvar = max(maxvar, stoi(ops[i].substr(3)));
+        }
+    }
+
+    // a reference ends the leading row/def opcodes, see bind
+    size_t k = 0;
+    while ((k < codes.size()) && (holes.empty() || (holes[0] > (int) k))
+           && ((codes[k].op == ROW) || (codes[k].op == DEFAULT))) {
+        hasPrefix = true;
+        if (codes[k].op == ROW) {
+            incr = codes[k].left;
+             if (debug_b) {log.debug("setting row incr to " + to_string(incr));};
+        } else {
+            hasdefault = true;
+            def = codes[k].left;
+            sdef = codes[k].sleft;
+             if (debug_b) {log.debug("setting default to " + sdef);};
+        }
+        ++k;
+    }
+    prefixLength = k;
+    codes.erase(codes.begin(), codes.begin() + k);
+    if (hasdefault) {maxvar = 1;}
+    link();
+    compiled = true;
+     if (debug_b) {log.debug("finished toOpcode.");};
+}
+
+// set the opcodes of the references for the current execution,
+// false if the values would change the leading row/def opcodes (compile all ops then)
+bool Program::bind(const List &ops) {
+    if (ops.size() != codes.size() + prefixLength) {return false;}
+    for (int i = 0; i < (int) holes.size(); ++i) {
+        int pos = holes[i];
+        const string &code = ops[pos];
+        Opcode op = toOpcode(code, pos);
+        int k = pos - prefixLength;
+        if ((k == 0) && ((op.op == ROW) || (op.op == DEFAULT))) {return false;}
+        if (!hasdefault && (code.substr(0,3)== "var")) {
+            maxvar = max(maxvar, stoi(code.substr(3)));
+        }
+        codes[k] = op;
+    }
+    link();
+    return true;
+}
+
+void Program::link() {
+    instrs.clear();
+    instrs.reserve(codes.size());
+    stackSize = 2;
+    backJump = false;
+    outs = 0;
+    for (int j = 0; j < (int) codes.size(); ++j) {
+        const Opcode &code = codes[j];
+        Instr in;
+        in.op = code.op;
+        in.operands = code.operands;
+        in.left = code.left;
+        in.hasLong = code.hasLong;
+        in.hasDouble = code.hasDouble;
+        in.lvalue = code.lvalue;
+        in.dvalue = code.dvalue;
+        in.code = j;
+        instrs.push_back(in);
+        if ((code.op == VAL) || (code.op == VAR) || (code.op == IDX)) {++stackSize;}
+        if ((code.op == SKIPZ) && (code.left < 0)) {backJump = true;}
+        if ((code.op == OUT) && (outs >= 0)) {++outs;}
+        if ((code.op == SKIPZ) || (code.op == END)) {outs = -1;}
+    }
+    checkKernel();
+}
+
+// a program without jumps, which never misses operands, is executed by the kernels
+// (only opcodes which are evaluated in the same way by the kernels)
+void Program::checkKernel() {
+    longKernel = true;
+    floatKernel = true;
+    depth = 0;
+    maxDepth = 0;
+    for (const Instr &in : instrs) {
+        if (depth < (int) in.operands) {
+            longKernel = false;
+            floatKernel = false;
+            break;
+        }
+        switch (in.op) {
+        case VAL:
+            if (!in.hasLong) {longKernel = false;}
+            if (!in.hasDouble) {floatKernel = false;}
+            ++depth;
+            break;
+        case VAR:
+        case IDX:
+            ++depth;
+            break;
+        case NOT:
+        case ABS:
+        case DIV:
+            break;
+        case CEIL:
+        case FLOOR:
+        case ROUND:
+        case SQRT:
+        case SIN:
+        case COS:
+        case TAN:
+        case ARCSIN:
+        case ARCCOS:
+        case ARCTAN:
+        case EXP:
+        case LOG:
+        case LOG10:
+        case SINH:
+        case COSH:
+        case TANH:
+            longKernel = false;
+            break;
+        case AND:
+        case OR:
+        case PLUS:
+        case MINUS:
+        case TIMES:
+        case DIVIDE:
+        case MOD:
+        case MAX:
+        case MIN:
+        case POWER:
+        case EQ:
+        case NEQ:
+        case GE:
+        case LE:
+        case GT:
+        case LT:
+        case OUT:
+        case DROP:
+            --depth;
+            break;
+        case ELVIS:
+            depth -= 2;
+            break;
+        default:
+            longKernel = false;
+            floatKernel = false;
+            break;
+        }
+        maxDepth = max(maxDepth, depth);
+    }
+    if (instrs.empty()) {
+        longKernel = false;
+        floatKernel = false;
+    }
+}
+
+// computes the result of a pexpr-int of plain values, as long as this gives no error (e.g. division by zero)
+bool Program::foldLong() {
+    if (!compiled || hasHoles() || hasPrefix || !longKernel) {return false;}
+    vector<long long int> st;
+    long long int ir;
+    for (const Instr &in : instrs) {
+        switch (in.op) {
+        case VAL:
+            st.push_back(in.lvalue);
+            break;
+        case NOT:
+            st.back() = (st.back() == 0) ? 1 : 0;
+            break;
+        case ABS:
+            st.back() = (st.back() >= 0) ? st.back() : -st.back();
+            break;
+        case ELVIS:
+            ir = st.back();
+            st.pop_back();
+            st[st.size() - 2] = (st[st.size() - 2] > 0) ? st.back() : ir;
+            st.pop_back();
+            break;
+        case DROP:
+            st.pop_back();
+            break;
+        default:
+            if ((in.operands != 2) || !applyLong(in.op, st[st.size() - 2], st.back(), ir)) {return false;}
+            st.pop_back();
+            st.back() = ir;
+            break;
+        }
+    }
+    // an empty result is reported when executing
+    if (st.empty()) {return false;}
+    vector<string> v;
+    for (long long int value : st) {
+        v.push_back(to_string(value));
+    }
+    constant = List(move(v), move(st));
+    folded = true;
+    return true;
+}
+
+// the result of a cond of a plain value (string)
+bool Program::foldValue() {
+    if (!compiled || hasHoles() || hasPrefix || (instrs.size() != 1) || (instrs[0].op != VAL)) {return false;}
+    constant = List(vector<string>{codes[0].sleft});
+    folded = true;
+    return true;
+}
+
+// binary operators of int as executed by the row loop, false for others and for a division by zero
+bool Program::applyLong(Codes op, long long int il, long long int ir, long long int &result) {
+    switch (op) {
+    case AND:
+        result = ((ir>0) && (il>0)) ? 1 : 0;
+        break;
+    case OR:
+        result = ((ir>0) || (il>0)) ? 1 : 0;
+        break;
+    case PLUS:
+        result = il + ir;
+        break;
+    case MINUS:
+        result = il - ir;
+        break;
+    case TIMES:
+        result = il * ir;
+        break;
+    case DIVIDE:
+    case MOD:
+        if ((ir == 0) || ((ir == -1) && (il == LLONG_MIN))) {return false;}
+        result = (op == DIVIDE) ? il / ir : il % ir;
+        break;
+    case MAX:
+        result = (ir >= il) ? ir : il;
+        break;
+    case MIN:
+        result = (ir <= il) ? ir : il;
+        break;
+    case EQ:
+        result = (il == ir) ? 1 : 0;
+        break;
+    case NEQ:
+        result = (il != ir) ? 1 : 0;
+        break;
+    case GE:
+        result = (il >= ir) ? 1 : 0;
+        break;
+    case LE:
+        result = (il <= ir) ? 1 : 0;
+        break;
+    case GT:
+        result = (il > ir) ? 1 : 0;
+        break;
+    case LT:
+        result = (il < ir) ? 1 : 0;
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+// comparisons and logical operators of float as executed by the row loop
+bool Program::testDouble(Codes op, double dl, double dr, bool &result) {
+    switch (op) {
+    case AND:
+        result = (dr>0) && (dl>0);
+        break;
+    case OR:
+        result = (dr>0) || (dl>0);
+        break;
+    case EQ:
+        result = (dl == dr);
+        break;
+    case NEQ:
+        result = (dl != dr);
+        break;
+    case GE:
+        result = (dl >= dr);
+        break;
+    case LE:
+        result = (dl <= dr);
+        break;
+    case GT:
+        result = (dl > dr);
+        break;
+    case LT:
+        result = (dl < dr);
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+// comparisons and logical operators of strings as executed by the row loop, numbers are compared by value
+bool Program::testString(Codes op, const string &sl, const string &sr, bool &result) {
+    switch (op) {
+    case AND:
+        result = (sr != "0") && (sl != "0");
+        break;
+    case OR:
+        result = (sr != "0") || (sl != "0");
+        break;
+    case EQ:
+        result = (sl == sr);
+        break;
+    case NEQ:
+        result = (sl != sr);
+        break;
+    case GE:
+        result = (isLong(sr) && isLong(sl)) ? (stoll(sl) >= stoll(sr)) : (sl >= sr);
+        break;
+    case LE:
+        result = (isLong(sr) && isLong(sl)) ? (stoll(sl) <= stoll(sr)) : (sl <= sr);
+        break;
+    case GT:
+        result = (isLong(sr) && isLong(sl)) ? (stoll(sl) > stoll(sr)) : (sl > sr);
+        break;
+    case LT:
+        result = (isLong(sr) && isLong(sl)) ? (stoll(sl) < stoll(sr)) : (sl < sr);
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+// true if toOpcode takes the code for a value which is pushed as it is (numbers are tested without toOpcode)
+bool Program::isPlainValue(const string &code) {
+    size_t k = ((code.size() > 1) && ((code[0] == '-') || (code[0] == '+'))) ? 1 : 0;
+    if ((k < code.size()) && isdigit((unsigned char) code[k])) {return true;}
+    try {
+        Opcode op = toOpcode(code, -1);
+        return (op.op == VAL) && (op.sleft == code);
+    } catch (exception &e) {
+        return false;
+    }
+}
+
+// true if parseValue gives a long (or a double) for the code, apart from values out of range
+bool Program::startsNumber(const string &code, bool isLong) {
+    size_t k = ((code.size() > 0) && ((code[0] == '-') || (code[0] == '+'))) ? 1 : 0;
+    if (!isLong && (k < code.size()) && (code[k] == '.')) {++k;}
+    return (k < code.size()) && isdigit((unsigned char) code[k]);
+}
+
+bool Program::isCompiled() {
+    return compiled;
+}
+
+bool Program::hasHoles() {
+    return holes.size() > 0;
+}
+
+// pos is the position of the code in the ops, plain values are also read from there
+Opcode Program::toOpcode(const string &code, int pos) {
+     if (debug_b) {log.debug("now processing " + code);};
+    Opcode op;
+    op.sleft = "";
+    op.operands = 2;
+        if (code.substr(0,3) == "row") {
+            op.op = ROW;
+            op.left = stoi(code.substr(3));
+            op.operands = 0;
+        } else if (code == "and"){
+            op.op = AND;
+            op.left = 0;
+        } else if (code == "or") {
+            op.op = OR;
+            op.left = 0;
+        } else if (code == "?") {
+            op.op = ELVIS;
+            op.left = 0;
+            op.operands = 3;
+         } else if (code == "+") {
+            op.op = PLUS;
+            op.left = 0;
+         } else if (code == "-") {
+            op.op = MINUS;
+            op.left = 0;
+         } else if (code == "*") {
+            op.op = TIMES;
+            op.left = 0;
+         } else if (code == "/") {
+            op.op = DIVIDE;
+            op.left = 0;
+         } else if (code == "&") {
+            op.op = CONCAT;
+            op.left = 0;
+         }  else if (code == "pwr") {
+            op.op = POWER;
+            op.left = 0;
+         } else if (code == "==") {
+            op.op = EQ;
+            op.left = 0;
+         } else if (code == "<>") {
+            op.op = NEQ;
+            op.left = 0;
+         } else if (code == ">=") {
+            op.op = GE;
+            op.left = 0;
+         } else if (code == "<=") {
+            op.op = LE;
+            op.left = 0;
+         } else if (code == ">") {
+            op.op = GT;
+            op.left = 0;
+         } else if (code == "<") {
+            op.op = LT;
+            op.left = 0;
+         } else if (code == "not") {
+            op.op = NOT;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "len") {
+            op.op = LEN;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "abs") {
+            op.op = ABS;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "sqrt") {
+            op.op = SQRT;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "ceil") {
+            op.op = CEIL;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "floor") {
+            op.op = FLOOR;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "round") {
+            op.op = ROUND;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "sin") {
+            op.op = SIN;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "cos") {
+            op.op = COS;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "tan") {
+            op.op = TAN;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "pi") {
+            op.op = VAL;
+            op.sleft = "3.141592653589793";
+            op.operands = 0;
+         } else if (code == "asin") {
+            op.op = ARCSIN;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "acos") {
+            op.op = ARCCOS;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "atan") {
+            op.op = ARCTAN;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "exp") {
+            op.op = EXP;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "log") {
+            op.op = LOG;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "log10") {
+            op.op = LOG10;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "sinh") {
+            op.op = SINH;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "cosh") {
+            op.op = COSH;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "tanh") {
+            op.op = TANH;
+            op.left = 0;
+            op.operands = 1;
+         } else if (code == "out") {
+            op.op = OUT;
+            op.left = 0;
+            op.operands = 1;
+        } else if (code == "%") {
+            op.op = MOD;
+            op.left = 0;
+        } else if ((code == "div") && isExtended) {
+            op.op = DIV;
+            op.left = 0;
+        } else if (code == "min") {
+            op.op = MIN;
+            op.left = 0;
+        } else if (code == "max") {
+            op.op = MAX;
+            op.left = 0;
+        } else if (code == "drop") {
+            op.op = DROP;
+            op.left = 0;
+            op.operands = 1;
+        } else if (code == "end") {
+            op.op = END;
+            op.left = 0;
+            op.operands = 0;
+        }else if (code.substr(0,4) == "skpz") {
+            op.op = SKIPZ;
+            op.left = stoi(code.substr(4));
+            op.operands = 1;
+        } else if (code.substr(0,3)== "val") {
+            op.op = VAL;
+            op.sleft = code.substr(3);
+            op.operands = 0;
+        } else if (code.substr(0,3)== "idx") {
+            op.op = IDX;
+            op.left = 0;
+            op.operands = 0;
+        } else if (code.substr(0,3)== "var") {
+            op.op = VAR;
+            op.operands = 0;
+            op.left = stoi(code.substr(3));
+        } else if ((code == "uget")&& isExtended) {
+            op.op = UGET;
+            op.left = 0;
+            op.operands = 1;
+        } else if ((code == "wget")&& isExtended) {
+            op.op = WGET;
+            op.left = 0;
+            op.operands = 1;
+        } else if (code == "isint") {
+            op.op = ISINT;
+            op.left = 0;
+            op.operands = 1;
+        } else if (code == "isnum") {
+            op.op = ISNUM;
+            op.left = 0;
+            op.operands = 1;
+        } else if (code == "upper") {
+            op.op = UPPER;
+            op.left = 0;
+            op.operands = 1;
+        } else if (code == "lower") {
+            op.op = LOWER;
+            op.left = 0;
+            op.operands = 1;
+        }else if (code.substr(0,3) == "def") {
+            op.op = DEFAULT;
+            op.sleft = code.substr(3);
+            op.operands = 0;
+            if (isInt(op.sleft)) {
+                op.left = stoi(op.sleft);
+                 if (debug_b) {log.debug("recognized default " + to_string(op.left));};
+            } else {
+                op.op = VAL;
+                op.sleft = code;
+                 if (debug_b) {log.debug(op.sleft + "regarded as var");};
+            }
+        } else {
+            // assume value and push item on stack
+            op.op = VAL;
+            op.sleft = code;
+            op.pos = pos;
+            op.operands = 0;
+        }
+        if (op.op == VAL) {
+            parseValue(op);
+        }
+        return op;
+}
+
+// pre-parse plain values, the run time conversion remains for anything else (and reports the errors)
+void Program::parseValue(Opcode &op) {
+    const string &s = op.sleft;
+    size_t k = 0;
+    if ((k < s.size()) && ((s[k] == '-') || (s[k] == '+'))) {++k;}
+    if ((k < s.size()) && isdigit(s[k])) {
+        try {
+            op.lvalue = stoll(s);
+            op.hasLong = true;
+        } catch (exception &e) {
+            // out of range
+        }
+    }
+    if ((k < s.size()) && (s[k] == '.')) {++k;}
+    if ((k < s.size()) && isdigit(s[k])) {
+        try {
+            op.dvalue = stod(s);
+            op.hasDouble = true;
+        } catch (exception &e) {
+            // out of range
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "Rowplan.h"
+#include "globals.h"
+
+Rowplan::Rowplan(const vector<string> &v)
+{
+    rowdefs.offset = 0;
+    rowdefs.rowlength = 1;
+    rowdefs.hasDefuse = false;
+    rowdefs.hasDefwith = false;
+    rowdefs.hasDefres = false;
+    foundBar = false;
+    readsResult = false;
+    string text;
+    string help;
+    int len = v.size();
+    int i = 0;
+    while (i<len) {
+        text = v[i];
+        if (text.substr(0, 3) == "row") {
+            help = text.substr(3);
+            if (!isInt(help)) {
+                errors.push_back(text);
+            } else {
+                rowdefs.rowlength = stoi(help);
+            }
+        } else if (text.substr(0, 3) == "def") {
+            rowdefs.defuse = text.substr(3);
+            rowdefs.hasDefuse = true;
+        } else if ((text.substr(0, 4) == "rdef") && isExtended) {
+            rowdefs.defres = text.substr(4);
+            rowdefs.hasDefres = true;
+        } else if ((text.substr(0, 4) == "wdef") && isExtended) {
+            rowdefs.defwith = text.substr(4);
+            rowdefs.hasDefwith = true;
+        } else if ((text.substr(0, 4) == "init") && isExtended) {
+            rowdefs.inits.push_back(text.substr(4));
+        } else if (text == "|") {
+            rowdefs.offset = i + 1;
+            foundBar = true;
+            break;
+        }
+        ++i;
+    }
+
+    // without bar the items start at 0
+    for (i = rowdefs.offset; i < len; ++i) {
+        if (isExtended || (v[i] != "#rend")) {
+            rowitems.push_back(Rowitem(v[i]));
+            if ((rowitems.back().typ == 4) || (rowitems.back().typ == 7)) {readsResult = true;}
+        }
+    }
+}
+
+Rowplan::~Rowplan()
+{
+    //dtor
+}
+
+// compile the items of a pexpr-int/float-perRow once, the slots # #n #wN #rN #index are the values set for
+// every row, see Interpreter::execRowplan
+void Rowplan::compile() {
+    if ((errors.size() > 0) || !foundBar) {return;}
+    vector<string> ops;
+    vector<int> holes;
+    for (const Rowitem &ri : rowitems) {
+        // #all gives rows of varying length
+        if (ri.typ == 6) {return;}
+        if (ri.typ == 0) {
+            ops.push_back(ri.plain);
+        } else {
+            holes.push_back(ops.size());
+            ops.push_back("");
+        }
+    }
+    if (ops.size() == 0) {return;}
+    shared_ptr<Program> prog = make_shared<Program>();
+    try {
+        prog->compile(ops, holes);
+    } catch (exception &e) {
+        // errors are reported at run time
+        return;
+    }
+    // row/def is not allowed in pexpr
+    if (prog->hasPrefix) {return;}
+    size_t h = 0;
+    for (const Rowitem &ri : rowitems) {
+        slots.push_back((ri.typ == 0) ? -1 : holes[h++]);
+    }
+    program = prog;
+}
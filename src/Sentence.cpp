@@ -27,6 +27,7 @@ Sentence::Sentence()
    header = false;
    saved = false;
    labelType = 0;
+   tailCall = false;
    seq =-1;
    name = "";
    condLevel = 0;
@@ -59,6 +60,11 @@ Item Sentence::getLastItem() {
     return result;
 }
 
+// the verb is always the last item of an executable sentence
+Item& Sentence::getVerb() {
+    return sentence.back();
+}
+
 vector<Item> Sentence::getSentence() {
     return sentence;
 }
@@ -88,6 +94,22 @@ bool Sentence::isSaved() {
 };
 
 
+void Sentence::addRelease(int index) {
+    releases.push_back(index);
+};
+
+vector<int>& Sentence::getReleases() {
+    return releases;
+};
+
+void Sentence::setTailCall() {
+    tailCall = true;
+};
+
+bool Sentence::isTailCall() {
+    return tailCall;
+};
+
 void Sentence::setSeq(int s) {
     seq = s;
 };
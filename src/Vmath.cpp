@@ -0,0 +1,254 @@
+/*
+Copyright 2022-23 Wolfgang Hermsen
+
+This file is part of the SOPL Interpreter.
+
+    The SOPL Interpreter is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The SOPL Interpreter is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the SOPL Interpreter.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "Vmath.h"
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+#include <float.h>
+
+using namespace std;
+
+// the interpreter does not trap floating point exceptions, without traps GCC can vectorize the selects below
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize ("no-trapping-math")
+#endif
+
+// with ifunc support (Linux) the columns are computed with AVX2 if the processor has it
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__linux__)
+#define COLUMN_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define COLUMN_CLONES
+#endif
+
+// the reductions and polynomials follow fdlibm (exp, log, __kernel_sin, __kernel_cos)
+
+// adding and subtracting SHIFT rounds to an integer, which is kept in the low bits of the sum
+static const double SHIFT = 0x1.8p52;
+static const double LOG2E = 1.44269504088896338700e+00;
+static const double LN2HI = 6.93147180369123816490e-01; // k * LN2HI is exact
+static const double LN2LO = 1.90821492927058770002e-10;
+static const double IVLN10 = 4.34294481903251816668e-01;
+static const double INVPIO2 = 6.36619772367581382433e-01;
+static const double PIO2_1 = 1.57079632673412561417e+00; // n * PIO2_x is exact for |n| < 2^20
+static const double PIO2_2 = 6.07710050630396597660e-11;
+static const double PIO2_3 = 2.02226624871116645580e-21;
+
+static const double EXPMAX = 708; // exp(x) is a normal number for |x| <= EXPMAX
+static const double TRIGMAX = 1e5; // larger sin/cos arguments need a more exact reduction
+
+static inline uint64_t bitsOf(double d) {
+    uint64_t u;
+    memcpy(&u, &d, sizeof(u));
+    return u;
+}
+
+static inline double fromBits(uint64_t u) {
+    double d;
+    memcpy(&d, &u, sizeof(d));
+    return d;
+}
+
+// exp for |x| <= EXPMAX
+static inline double expCore(double x) {
+    double k = (x * LOG2E + SHIFT) - SHIFT;
+    double r = (x - k * LN2HI) - k * LN2LO;
+    double p = 1 + r * (1 + r * (1.0 / 2 + r * (1.0 / 6 + r * (1.0 / 24 + r * (1.0 / 120 + r * (1.0 / 720
+                 + r * (1.0 / 5040 + r * (1.0 / 40320 + r * (1.0 / 362880 + r * (1.0 / 3628800
+                 + r * (1.0 / 39916800 + r * (1.0 / 479001600 + r * (1.0 / 6227020800)))))))))))));
+    // 2^k, k is in the low bits of k + SHIFT
+    return p * fromBits((bitsOf(k + SHIFT) + 1023) << 52);
+}
+
+// log for normal positive x
+static inline double logCore(double x) {
+    // x = 2^e * m with m in [sqrt(2)/2, sqrt(2))
+    uint64_t u = bitsOf(x) + (0x3ff0000000000000ULL - 0x3fe6a09e667f3bcdULL);
+    double e = fromBits(0x4330000000000000ULL | (u >> 52)) - (0x1p52 + 1023);
+    double f = fromBits((u & 0x000fffffffffffffULL) + 0x3fe6a09e667f3bcdULL) - 1;
+    double hfsq = 0.5 * f * f;
+    double s = f / (2 + f);
+    double z = s * s;
+    double w = z * z;
+    double t1 = w * (3.999999999940941908e-01 + w * (2.222219843214978396e-01 + w * 1.531383769920937332e-01));
+    double t2 = z * (6.666666666666735130e-01 + w * (2.857142874366239149e-01 + w * (1.818357216161805012e-01
+                + w * 1.479819860511658591e-01)));
+    return s * (hfsq + t1 + t2) + e * LN2LO - hfsq + f + e * LN2HI;
+}
+
+// x = q * pi/2 + r with |r| <= pi/4 and q = 0..3, sr = sin(r), cr = cos(r) (for |x| <= TRIGMAX)
+static inline void reduceCore(double x, double &sr, double &cr, double &q) {
+    double a = ((x >= -TRIGMAX) & (x <= TRIGMAX)) ? x : 0;
+    double t = (a * INVPIO2 + SHIFT) - SHIFT;
+    double r = ((a - t * PIO2_1) - t * PIO2_2) - t * PIO2_3;
+    double z = r * r;
+    sr = r + r * z * (-1.66666666666666324348e-01 + z * (8.33333333332248946124e-03
+         + z * (-1.98412698298579493134e-04 + z * (2.75573137070700676789e-06
+         + z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)))));
+    cr = 1 - 0.5 * z + z * z * (4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03
+         + z * (2.48015872894767294178e-05 + z * (-2.75573143513906633035e-07
+         + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11)))));
+    double m = t - 4 * ((t * 0.25 + SHIFT) - SHIFT);
+    q = (m < 0) ? m + 4 : m;
+}
+
+Vmath::Vmath()
+{
+    //ctor
+    help.resize(COLUMN);
+}
+
+Vmath::~Vmath()
+{
+    //dtor
+}
+
+// the arguments are kept in help, those outside the range of the approximation are computed by libm
+
+COLUMN_CLONES void Vmath::vexp(double * __restrict x) {
+    double * __restrict y = help.data();
+    for (int k = 0; k < COLUMN; ++k) {
+        double v = x[k];
+        y[k] = v;
+        x[k] = expCore(((v >= -EXPMAX) & (v <= EXPMAX)) ? v : 0);
+    }
+    for (int k = 0; k < COLUMN; ++k) {
+        if (!((y[k] >= -EXPMAX) && (y[k] <= EXPMAX))) {x[k] = exp(y[k]);}
+    }
+}
+
+COLUMN_CLONES void Vmath::vlog(double * __restrict x) {
+    double * __restrict y = help.data();
+    for (int k = 0; k < COLUMN; ++k) {
+        double v = x[k];
+        y[k] = v;
+        x[k] = logCore(((v >= DBL_MIN) & (v <= DBL_MAX)) ? v : 1);
+    }
+    for (int k = 0; k < COLUMN; ++k) {
+        if (!((y[k] >= DBL_MIN) && (y[k] <= DBL_MAX))) {x[k] = log(y[k]);}
+    }
+}
+
+// results close to an integer are taken from libm, so that e.g. log10(1000) stays exactly 3
+COLUMN_CLONES void Vmath::vlog10(double * __restrict x) {
+    double * __restrict y = help.data();
+    for (int k = 0; k < COLUMN; ++k) {
+        double v = x[k];
+        y[k] = v;
+        x[k] = logCore(((v >= DBL_MIN) & (v <= DBL_MAX)) ? v : 1) * IVLN10;
+    }
+    for (int k = 0; k < COLUMN; ++k) {
+        double d = x[k] - ((x[k] + SHIFT) - SHIFT);
+        if (!((y[k] >= DBL_MIN) && (y[k] <= DBL_MAX)) || ((d > -1e-12) && (d < 1e-12))) {x[k] = log10(y[k]);}
+    }
+}
+
+// the polynomial gives 0 for -0
+COLUMN_CLONES void Vmath::vsin(double * __restrict x) {
+    double * __restrict y = help.data();
+    for (int k = 0; k < COLUMN; ++k) {
+        double sr, cr, q;
+        double v = x[k];
+        y[k] = v;
+        reduceCore(v, sr, cr, q);
+        v = ((q == 0) | (q == 2)) ? sr : cr;
+        x[k] = (q >= 2) ? -v : v;
+    }
+    for (int k = 0; k < COLUMN; ++k) {
+        if (!((y[k] >= -TRIGMAX) && (y[k] <= TRIGMAX) && (y[k] != 0))) {x[k] = sin(y[k]);}
+    }
+}
+
+COLUMN_CLONES void Vmath::vcos(double * __restrict x) {
+    double * __restrict y = help.data();
+    for (int k = 0; k < COLUMN; ++k) {
+        double sr, cr, q;
+        double v = x[k];
+        y[k] = v;
+        reduceCore(v, sr, cr, q);
+        v = ((q == 0) | (q == 2)) ? cr : sr;
+        x[k] = ((q == 1) | (q == 2)) ? -v : v;
+    }
+    for (int k = 0; k < COLUMN; ++k) {
+        if (!((y[k] >= -TRIGMAX) && (y[k] <= TRIGMAX))) {x[k] = cos(y[k]);}
+    }
+}
+
+COLUMN_CLONES void Vmath::vtan(double * __restrict x) {
+    double * __restrict y = help.data();
+    for (int k = 0; k < COLUMN; ++k) {
+        double sr, cr, q;
+        double v = x[k];
+        y[k] = v;
+        reduceCore(v, sr, cr, q);
+        double num = ((q == 0) | (q == 2)) ? sr : -cr;
+        double den = ((q == 0) | (q == 2)) ? cr : sr;
+        x[k] = num / den;
+    }
+    for (int k = 0; k < COLUMN; ++k) {
+        if (!((y[k] >= -TRIGMAX) && (y[k] <= TRIGMAX) && (y[k] != 0))) {x[k] = tan(y[k]);}
+    }
+}
+
+// the difference of exp(x) and exp(-x) loses too many bits for small x
+COLUMN_CLONES void Vmath::vsinh(double * __restrict x) {
+    double * __restrict y = help.data();
+    for (int k = 0; k < COLUMN; ++k) {
+        double v = x[k];
+        y[k] = v;
+        double a = (v >= 0) ? v : -v;
+        double e = expCore(((a >= 1) & (a <= EXPMAX)) ? a : 1);
+        double r = 0.5 * (e - 1 / e);
+        x[k] = (v >= 0) ? r : -r;
+    }
+    for (int k = 0; k < COLUMN; ++k) {
+        double a = fabs(y[k]);
+        if (!((a >= 1) && (a <= EXPMAX))) {x[k] = sinh(y[k]);}
+    }
+}
+
+COLUMN_CLONES void Vmath::vcosh(double * __restrict x) {
+    double * __restrict y = help.data();
+    for (int k = 0; k < COLUMN; ++k) {
+        double v = x[k];
+        y[k] = v;
+        double a = (v >= 0) ? v : -v;
+        double e = expCore((a <= EXPMAX) ? a : 0);
+        x[k] = 0.5 * (e + 1 / e);
+    }
+    for (int k = 0; k < COLUMN; ++k) {
+        if (!(fabs(y[k]) <= EXPMAX)) {x[k] = cosh(y[k]);}
+    }
+}
+
+// tanh(x) = 1 - 2 / (exp(2x) + 1), which rounds to 1 for x > 20
+COLUMN_CLONES void Vmath::vtanh(double * __restrict x) {
+    double * __restrict y = help.data();
+    for (int k = 0; k < COLUMN; ++k) {
+        double v = x[k];
+        y[k] = v;
+        double a = (v >= 0) ? v : -v;
+        double r = 1 - 2 / (expCore(2 * (((a >= 0.55) & (a <= 20)) ? a : 20)) + 1);
+        x[k] = (v >= 0) ? r : -r;
+    }
+    for (int k = 0; k < COLUMN; ++k) {
+        if (!(fabs(y[k]) >= 0.55)) {x[k] = tanh(y[k]);}
+    }
+}
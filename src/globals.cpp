@@ -27,7 +27,7 @@ bool isExtended = false;
  vector<string> standard = {"cond", "del", "expand", "file", "find", "freq", "get", "id", "include", "input", "ins", "join", "mask", "minus",
             "output", "pexpr", "print", "range", "readLines", "reverse", "returnValue", "set", "sort", "split", "time", "unique", "writeLines"};
  vector<string> other = {"plist", "between", "nop", "stop"};
- vector<string> vmods = {"combine", "echo", "echoIn", "echoOut", "perRow", "int", "float", "forget"};
+ vector<string> vmods = {"combine", "echo", "echoIn", "echoOut", "perRow", "int", "float", "forget", "memo", "parallel"};
 bool debug_L = false;
 bool debug_P = false;
 bool debug_I = false;